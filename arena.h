@@ -0,0 +1,136 @@
+#pragma once
+
+#include "shared.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Bump-allocated region. Objects are destroyed in reverse order of creation and the
+// chunks are freed together with the region. Allocation is not thread-safe.
+class ArenaRegion {
+public:
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+    static constexpr size_t kMaxChunkSize = 64 * 1024 * 1024;
+
+    explicit ArenaRegion(size_t chunk_size = kDefaultChunkSize) : chunk_size_(chunk_size) {
+    }
+
+    ArenaRegion(const ArenaRegion&) = delete;
+    ArenaRegion& operator=(const ArenaRegion&) = delete;
+
+    ~ArenaRegion() {
+        for (auto node = destructors_; node; node = node->next) {
+            node->destroy(node->object);
+        }
+        while (chunks_) {
+            auto next = chunks_->next;
+            ::operator delete(chunks_);
+            chunks_ = next;
+        }
+    }
+
+    void* Allocate(size_t size, size_t alignment) {
+        void* ptr = std::align(alignment, size, cursor_, space_);
+        if (!ptr) {
+            NewChunk(size + alignment);
+            ptr = std::align(alignment, size, cursor_, space_);
+        }
+        cursor_ = static_cast<char*>(ptr) + size;
+        space_ -= size;
+        return ptr;
+    }
+
+    template <typename T, typename... Args>
+    T* Create(Args&&... args) {
+        void* place = Allocate(sizeof(T), alignof(T));
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            return new (place) T(std::forward<Args>(args)...);
+        } else {
+            auto node = new (Allocate(sizeof(DestructorNode), alignof(DestructorNode)))
+                DestructorNode;
+            T* obj = new (place) T(std::forward<Args>(args)...);
+            node->destroy = [](void* obj) { static_cast<T*>(obj)->~T(); };
+            node->object = obj;
+            node->next = destructors_;
+            destructors_ = node;
+            return obj;
+        }
+    }
+
+    size_t BytesReserved() const {
+        return bytes_reserved_;
+    }
+
+private:
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next;
+    };
+
+    struct DestructorNode {
+        void (*destroy)(void*);
+        void* object;
+        DestructorNode* next;
+    };
+
+    // Chunk sizes double up to `kMaxChunkSize`, so large regions need few chunks
+    void NewChunk(size_t min_size) {
+        size_t size = std::max(chunk_size_, min_size + sizeof(Chunk));
+        chunk_size_ = std::max(chunk_size_, std::min(chunk_size_ * 2, kMaxChunkSize));
+        auto chunk = static_cast<Chunk*>(::operator new(size));
+        chunk->next = chunks_;
+        chunks_ = chunk;
+        cursor_ = chunk + 1;
+        space_ = size - sizeof(Chunk);
+        bytes_reserved_ += size;
+    }
+
+    size_t chunk_size_;
+    size_t bytes_reserved_ = 0;
+    Chunk* chunks_ = nullptr;
+    DestructorNode* destructors_ = nullptr;
+    void* cursor_ = nullptr;
+    size_t space_ = 0;
+};
+
+// Arena whose nodes are handed out through the aliasing constructor: every handle shares
+// the single control block of the region, and the last one to go frees the whole graph.
+// Nodes may point at each other with raw pointers obtained from `Create()`.
+template <typename CountPolicy = SingleThreadedCount>
+class BasicSharedArena {
+public:
+    explicit BasicSharedArena(size_t chunk_size = ArenaRegion::kDefaultChunkSize)
+        : region_(MakeBasicShared<ArenaRegion, CountPolicy>(chunk_size)) {
+    }
+
+    // Lives as long as the arena or any handle into it
+    template <typename T, typename... Args>
+    T* Create(Args&&... args) {
+        return region_->template Create<T>(std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename... Args>
+    BasicSharedPtr<T, CountPolicy> Make(Args&&... args) {
+        return Share(Create<T>(std::forward<Args>(args)...));
+    }
+
+    // `node` must come from this arena
+    template <typename T>
+    BasicSharedPtr<T, CountPolicy> Share(T* node) const {
+        return BasicSharedPtr<T, CountPolicy>(region_, node);
+    }
+
+    const BasicSharedPtr<ArenaRegion, CountPolicy>& GetRegion() const {
+        return region_;
+    }
+
+private:
+    BasicSharedPtr<ArenaRegion, CountPolicy> region_;
+};
+
+using SharedArena = BasicSharedArena<>;
+
+using SyncSharedArena = BasicSharedArena<AtomicCount>;
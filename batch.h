@@ -0,0 +1,264 @@
+#pragma once
+
+#include "shared.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace batch_detail {
+
+// Coalesces count changes on the last few control blocks seen, so a run of handles
+// sharing a block costs one counter update instead of one per handle.
+// Pending increments are applied on `Flush()` or destruction. Until then the copies made
+// by `Share()` hold no reference of their own: they may only be released through the same
+// batch, and the handle they were copied from must stay alive or also be released through
+// it, or the last real owner frees the object under them. Only the helpers below use it.
+template <typename CountPolicy>
+class SharedCountBatch {
+public:
+    using Block = BasicControlBlock<CountPolicy>;
+
+    static constexpr size_t kSlots = 8;
+
+    SharedCountBatch() {
+    }
+
+    SharedCountBatch(const SharedCountBatch&) = delete;
+    SharedCountBatch& operator=(const SharedCountBatch&) = delete;
+
+    ~SharedCountBatch() {
+        Flush();
+    }
+
+    // Returns a copy of `ptr` whose increment is deferred
+    template <typename T>
+    BasicSharedPtr<T, CountPolicy> Share(const BasicSharedPtr<T, CountPolicy>& ptr) {
+        Add(increments_, increments_size_, ptr.GetControlBlock());
+        return BasicSharedPtr<T, CountPolicy>(ptr.Get(), ptr.GetControlBlock());
+    }
+
+    // Empties `ptr`, deferring its decrement
+    template <typename T>
+    void Release(BasicSharedPtr<T, CountPolicy>& ptr) {
+        Add(decrements_, decrements_size_, ptr.Detach());
+    }
+
+    void Flush() {
+        Apply(increments_, increments_size_, false);
+        Apply(decrements_, decrements_size_, true);
+    }
+
+private:
+    struct Pending {
+        Block* block;
+        int count;
+    };
+
+    void Add(Pending* pending, size_t& size, Block* block) {
+        if (!block) {
+            return;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            if (pending[i].block == block) {
+                ++pending[i].count;
+                return;
+            }
+        }
+        // Increments go first, so a pending decrement never outruns the copy it pairs with
+        if (size == kSlots) {
+            Flush();
+        }
+        pending[size++] = {block, 1};
+    }
+
+    static void Apply(Pending* pending, size_t& size, bool release) {
+        for (size_t i = 0; i < size; ++i) {
+            if (release) {
+                pending[i].block->DecrementShared(pending[i].count);
+            } else {
+                pending[i].block->IncrementShared(pending[i].count);
+            }
+        }
+        size = 0;
+    }
+
+    Pending increments_[kSlots];
+    size_t increments_size_ = 0;
+    Pending decrements_[kSlots];
+    size_t decrements_size_ = 0;
+};
+
+}  // namespace batch_detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Range helpers
+
+// Appends copies of [first, last) to `out`
+template <typename It, typename T, typename CountPolicy>
+void CopyShared(It first, It last, std::vector<BasicSharedPtr<T, CountPolicy>>& out) {
+    out.reserve(out.size() + std::distance(first, last));
+    batch_detail::SharedCountBatch<CountPolicy> batch;
+    for (; first != last; ++first) {
+        out.push_back(batch.Share(*first));
+    }
+}
+
+template <typename T, typename CountPolicy>
+std::vector<BasicSharedPtr<T, CountPolicy>> CopyShared(
+    const std::vector<BasicSharedPtr<T, CountPolicy>>& range) {
+    std::vector<BasicSharedPtr<T, CountPolicy>> out;
+    CopyShared(range.begin(), range.end(), out);
+    return out;
+}
+
+// Empties every handle in [first, last)
+template <typename It>
+void ReleaseAll(It first, It last) {
+    using Ptr = typename std::iterator_traits<It>::value_type;
+    batch_detail::SharedCountBatch<typename Ptr::Policy> batch;
+    for (; first != last; ++first) {
+        batch.Release(*first);
+    }
+}
+
+template <typename T, typename CountPolicy>
+void ReleaseAll(std::vector<BasicSharedPtr<T, CountPolicy>>& range) {
+    ReleaseAll(range.begin(), range.end());
+    range.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Vector of handles copied and destroyed in bulk
+
+template <typename T, typename CountPolicy = SingleThreadedCount>
+class BasicSharedPtrVector {
+public:
+    using Ptr = BasicSharedPtr<T, CountPolicy>;
+    using Iterator = typename std::vector<Ptr>::iterator;
+    using ConstIterator = typename std::vector<Ptr>::const_iterator;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Constructors
+
+    BasicSharedPtrVector() {
+    }
+
+    BasicSharedPtrVector(size_t count, const Ptr& value) {
+        Assign(count, value);
+    }
+
+    BasicSharedPtrVector(std::initializer_list<Ptr> values) {
+        CopyShared(values.begin(), values.end(), ptrs_);
+    }
+
+    BasicSharedPtrVector(const BasicSharedPtrVector& other) {
+        CopyShared(other.begin(), other.end(), ptrs_);
+    }
+
+    BasicSharedPtrVector(BasicSharedPtrVector&& other) noexcept : ptrs_(std::move(other.ptrs_)) {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // `operator=`-s
+
+    BasicSharedPtrVector& operator=(const BasicSharedPtrVector& other) {
+        BasicSharedPtrVector(other).Swap(*this);
+        return *this;
+    }
+
+    BasicSharedPtrVector& operator=(BasicSharedPtrVector&& other) noexcept {
+        BasicSharedPtrVector(std::move(other)).Swap(*this);
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Destructor
+
+    ~BasicSharedPtrVector() {
+        Clear();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Modifiers
+
+    void Assign(size_t count, const Ptr& value) {
+        Ptr keep = value;
+        Clear();
+        ptrs_.reserve(count);
+        batch_detail::SharedCountBatch<CountPolicy> batch;
+        for (size_t i = 0; i < count; ++i) {
+            ptrs_.push_back(batch.Share(keep));
+        }
+    }
+
+    void PushBack(const Ptr& value) {
+        ptrs_.push_back(value);
+    }
+
+    void PushBack(Ptr&& value) {
+        ptrs_.push_back(std::move(value));
+    }
+
+    void PopBack() {
+        ptrs_.pop_back();
+    }
+
+    void Reserve(size_t capacity) {
+        ptrs_.reserve(capacity);
+    }
+
+    void Clear() {
+        ReleaseAll(ptrs_);
+    }
+
+    void Swap(BasicSharedPtrVector& other) noexcept {
+        ptrs_.swap(other.ptrs_);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Observers
+
+    size_t Size() const {
+        return ptrs_.size();
+    }
+
+    bool Empty() const {
+        return ptrs_.empty();
+    }
+
+    Ptr& operator[](size_t i) {
+        return ptrs_[i];
+    }
+
+    const Ptr& operator[](size_t i) const {
+        return ptrs_[i];
+    }
+
+    Iterator begin() {
+        return ptrs_.begin();
+    }
+
+    Iterator end() {
+        return ptrs_.end();
+    }
+
+    ConstIterator begin() const {
+        return ptrs_.begin();
+    }
+
+    ConstIterator end() const {
+        return ptrs_.end();
+    }
+
+private:
+    std::vector<Ptr> ptrs_;
+};
+
+template <typename T>
+using SharedPtrVector = BasicSharedPtrVector<T>;
+
+template <typename T>
+using SyncSharedPtrVector = BasicSharedPtrVector<T, AtomicCount>;
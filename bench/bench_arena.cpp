@@ -0,0 +1,121 @@
+#include "arena.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+// Build and drop a 1M-node binary tree: one `MakeShared` per node vs one `SharedArena`
+
+namespace {
+
+constexpr int64_t kNodes = 1 << 20;
+
+// Each drop needs a fresh graph built with the timer paused
+constexpr int64_t kDropIterations = 20;
+
+template <typename CountPolicy>
+struct SharedNode {
+    BasicSharedPtr<SharedNode, CountPolicy> left;
+    BasicSharedPtr<SharedNode, CountPolicy> right;
+    long value = 0;
+};
+
+struct ArenaNode {
+    ArenaNode* left = nullptr;
+    ArenaNode* right = nullptr;
+    long value = 0;
+};
+
+// Children of node i are 2i + 1 and 2i + 2, so teardown recursion stays shallow
+template <typename CountPolicy>
+BasicSharedPtr<SharedNode<CountPolicy>, CountPolicy> BuildShared(int64_t size) {
+    std::vector<BasicSharedPtr<SharedNode<CountPolicy>, CountPolicy>> nodes(size);
+    for (int64_t i = size - 1; i >= 0; --i) {
+        nodes[i] = MakeBasicShared<SharedNode<CountPolicy>, CountPolicy>();
+        nodes[i]->value = i;
+        if (2 * i + 1 < size) {
+            nodes[i]->left = std::move(nodes[2 * i + 1]);
+        }
+        if (2 * i + 2 < size) {
+            nodes[i]->right = std::move(nodes[2 * i + 2]);
+        }
+    }
+    return std::move(nodes[0]);
+}
+
+template <typename CountPolicy>
+BasicSharedPtr<ArenaNode, CountPolicy> BuildArena(int64_t size) {
+    BasicSharedArena<CountPolicy> arena;
+    std::vector<ArenaNode*> nodes(size);
+    for (int64_t i = size - 1; i >= 0; --i) {
+        nodes[i] = arena.template Create<ArenaNode>();
+        nodes[i]->value = i;
+        if (2 * i + 1 < size) {
+            nodes[i]->left = nodes[2 * i + 1];
+        }
+        if (2 * i + 2 < size) {
+            nodes[i]->right = nodes[2 * i + 2];
+        }
+    }
+    return arena.Share(nodes[0]);
+}
+
+template <typename CountPolicy>
+void BM_SharedBuildAndDrop(benchmark::State& state) {
+    for (auto _ : state) {
+        auto root = BuildShared<CountPolicy>(kNodes);
+        benchmark::DoNotOptimize(root.Get());
+    }
+    state.SetItemsProcessed(state.iterations() * kNodes);
+}
+
+template <typename CountPolicy>
+void BM_ArenaBuildAndDrop(benchmark::State& state) {
+    for (auto _ : state) {
+        auto root = BuildArena<CountPolicy>(kNodes);
+        benchmark::DoNotOptimize(root.Get());
+    }
+    state.SetItemsProcessed(state.iterations() * kNodes);
+}
+
+template <typename CountPolicy>
+void BM_SharedDrop(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto root = BuildShared<CountPolicy>(kNodes);
+        state.ResumeTiming();
+        root.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * kNodes);
+}
+
+template <typename CountPolicy>
+void BM_ArenaDrop(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto root = BuildArena<CountPolicy>(kNodes);
+        state.ResumeTiming();
+        root.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * kNodes);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SharedBuildAndDrop, SingleThreadedCount)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ArenaBuildAndDrop, SingleThreadedCount)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SharedBuildAndDrop, AtomicCount)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ArenaBuildAndDrop, AtomicCount)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_SharedDrop, SingleThreadedCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(kDropIterations);
+BENCHMARK_TEMPLATE(BM_ArenaDrop, SingleThreadedCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(kDropIterations);
+BENCHMARK_TEMPLATE(BM_SharedDrop, AtomicCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(kDropIterations);
+BENCHMARK_TEMPLATE(BM_ArenaDrop, AtomicCount)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(kDropIterations);
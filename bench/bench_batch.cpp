@@ -0,0 +1,112 @@
+#include "batch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+// Fan-out: `range(0)` elements sharing `range(1)` distinct snapshots, atomic counts
+
+namespace {
+
+struct Snapshot {
+    long version = 0;
+};
+
+using Ptr = SyncSharedPtr<Snapshot>;
+
+std::vector<Ptr> MakeFanOut(int64_t size, int64_t snapshots) {
+    std::vector<Ptr> distinct;
+    for (int64_t i = 0; i < snapshots; ++i) {
+        distinct.push_back(MakeSyncShared<Snapshot>());
+    }
+    std::vector<Ptr> ptrs;
+    ptrs.reserve(size);
+    for (int64_t i = 0; i < size; ++i) {
+        ptrs.push_back(distinct[i % snapshots]);
+    }
+    return ptrs;
+}
+
+void BM_VectorCopy(benchmark::State& state) {
+    auto ptrs = MakeFanOut(state.range(0), state.range(1));
+    for (auto _ : state) {
+        std::vector<Ptr> copy = ptrs;
+        benchmark::DoNotOptimize(copy.data());
+        state.PauseTiming();
+        copy.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CopyShared(benchmark::State& state) {
+    auto ptrs = MakeFanOut(state.range(0), state.range(1));
+    for (auto _ : state) {
+        auto copy = CopyShared(ptrs);
+        benchmark::DoNotOptimize(copy.data());
+        state.PauseTiming();
+        ReleaseAll(copy);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_VectorDestroy(benchmark::State& state) {
+    auto ptrs = MakeFanOut(state.range(0), state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Ptr> copy = ptrs;
+        state.ResumeTiming();
+        copy.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ReleaseAll(benchmark::State& state) {
+    auto ptrs = MakeFanOut(state.range(0), state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto copy = CopyShared(ptrs);
+        state.ResumeTiming();
+        ReleaseAll(copy);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Copy and drop a whole fan-out, every thread on the same snapshots
+void BM_VectorRoundTripContended(benchmark::State& state) {
+    static auto ptrs = MakeFanOut(4096, 1);
+    for (auto _ : state) {
+        std::vector<Ptr> copy = ptrs;
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * ptrs.size());
+}
+
+void BM_SharedPtrVectorRoundTripContended(benchmark::State& state) {
+    static auto ptrs = MakeFanOut(4096, 1);
+    static SyncSharedPtrVector<Snapshot> vector(ptrs.size(), ptrs.front());
+    for (auto _ : state) {
+        SyncSharedPtrVector<Snapshot> copy = vector;
+        benchmark::DoNotOptimize(&copy);
+    }
+    state.SetItemsProcessed(state.iterations() * ptrs.size());
+}
+
+void FanOutArgs(benchmark::internal::Benchmark* bench) {
+    for (int64_t size : {1024, 16384}) {
+        for (int64_t snapshots : {1, 4, 64}) {
+            bench->Args({size, snapshots});
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_VectorCopy)->Apply(FanOutArgs);
+BENCHMARK(BM_CopyShared)->Apply(FanOutArgs);
+BENCHMARK(BM_VectorDestroy)->Apply(FanOutArgs);
+BENCHMARK(BM_ReleaseAll)->Apply(FanOutArgs);
+
+BENCHMARK(BM_VectorRoundTripContended)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_SharedPtrVectorRoundTripContended)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,84 @@
+#include "buffer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+// Cut a 64 KiB payload into `range(0)`-byte fragments and keep them:
+// `SharedSlice`s into one buffer vs a `std::vector<char>` copy per fragment
+
+namespace {
+
+constexpr size_t kPayload = 64 * 1024;
+
+template <typename CountPolicy>
+void BM_SharedSlices(benchmark::State& state) {
+    size_t fragment = state.range(0);
+    auto buffer = BasicSharedBuffer<CountPolicy>::Allocate(kPayload);
+    std::memset(buffer.Data(), 'x', kPayload);
+    std::vector<BasicSharedSlice<CountPolicy>> fragments;
+    fragments.reserve(kPayload / fragment);
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < kPayload; offset += fragment) {
+            fragments.push_back(buffer.Slice(offset, fragment));
+        }
+        benchmark::DoNotOptimize(fragments.data());
+        fragments.clear();
+    }
+    state.SetBytesProcessed(state.iterations() * kPayload);
+}
+
+void BM_VectorCopies(benchmark::State& state) {
+    size_t fragment = state.range(0);
+    std::vector<char> payload(kPayload, 'x');
+    std::vector<std::vector<char>> fragments;
+    fragments.reserve(kPayload / fragment);
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < kPayload; offset += fragment) {
+            fragments.emplace_back(payload.begin() + offset, payload.begin() + offset + fragment);
+        }
+        benchmark::DoNotOptimize(fragments.data());
+        fragments.clear();
+    }
+    state.SetBytesProcessed(state.iterations() * kPayload);
+}
+
+// Pass one fragment down a pipeline of `range(0)` stages, each keeping a copy
+template <typename CountPolicy>
+void BM_SharedSlicePipeline(benchmark::State& state) {
+    auto buffer = BasicSharedBuffer<CountPolicy>::Allocate(kPayload);
+    std::memset(buffer.Data(), 'x', kPayload);
+    std::vector<BasicSharedSlice<CountPolicy>> stages(state.range(0));
+    for (auto _ : state) {
+        auto slice = buffer.Slice(0, 4096);
+        for (auto& stage : stages) {
+            stage = slice;
+            slice = stage.Slice(1);
+        }
+        benchmark::DoNotOptimize(slice.Data());
+    }
+}
+
+void BM_VectorPipeline(benchmark::State& state) {
+    std::vector<char> payload(kPayload, 'x');
+    std::vector<std::vector<char>> stages(state.range(0));
+    for (auto _ : state) {
+        std::vector<char> slice(payload.begin(), payload.begin() + 4096);
+        for (auto& stage : stages) {
+            stage = slice;
+            slice.assign(stage.begin() + 1, stage.end());
+        }
+        benchmark::DoNotOptimize(slice.data());
+    }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SharedSlices, SingleThreadedCount)->RangeMultiplier(8)->Range(64, 16384);
+BENCHMARK_TEMPLATE(BM_SharedSlices, AtomicCount)->RangeMultiplier(8)->Range(64, 16384);
+BENCHMARK(BM_VectorCopies)->RangeMultiplier(8)->Range(64, 16384);
+
+BENCHMARK_TEMPLATE(BM_SharedSlicePipeline, SingleThreadedCount)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_SharedSlicePipeline, AtomicCount)->Arg(4)->Arg(16);
+BENCHMARK(BM_VectorPipeline)->Arg(4)->Arg(16);
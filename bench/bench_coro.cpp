@@ -0,0 +1,146 @@
+#include "coro.h"
+
+#include <benchmark/benchmark.h>
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Task spawn and completion: pooled `PinnedTask` frames vs a plain heap-allocated task, one
+// pin per task vs a `SharedFromThis()` copy per `co_await`, and nested `co_await` chains
+
+namespace {
+
+// Minimal lazy task whose frame comes from the global `operator new`
+struct HeapTask {
+    struct promise_type {
+        HeapTask get_return_object() {
+            return HeapTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {
+        }
+
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+
+    explicit HeapTask(std::coroutine_handle<promise_type> handle) : handle(handle) {
+    }
+
+    HeapTask(HeapTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {
+    }
+
+    ~HeapTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    void Resume() {
+        handle.resume();
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Suspends until the benchmark loop resumes `parked`
+std::coroutine_handle<> parked;
+
+struct Park {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        parked = handle;
+    }
+
+    void await_resume() const noexcept {
+    }
+};
+
+struct Service : EnableSharedFromThis<Service> {
+    // Pinned once for the whole task
+    PinnedTask Handle(int64_t suspensions) {
+        for (int64_t i = 0; i < suspensions; ++i) {
+            co_await Park{};
+            benchmark::DoNotOptimize(value);
+        }
+    }
+
+    long value = 0;
+};
+
+// The object is reached through a handle, so nothing is pinned; every suspension copies
+PinnedTask HandleWithCopies(SharedPtr<Service> service, int64_t suspensions) {
+    for (int64_t i = 0; i < suspensions; ++i) {
+        auto self = service->SharedFromThis();
+        co_await Park{};
+        benchmark::DoNotOptimize(self->value);
+    }
+}
+
+template <typename Task>
+Task Empty(long& value) {
+    benchmark::DoNotOptimize(++value);
+    co_return;
+}
+
+PinnedTask Nested(int64_t depth) {
+    if (depth) {
+        auto inner = Nested(depth - 1);
+        co_await inner;
+    }
+}
+
+template <typename Task>
+void BM_SpawnEmpty(benchmark::State& state) {
+    long value = 0;
+    for (auto _ : state) {
+        auto task = Empty<Task>(value);
+        task.Resume();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <bool kPinned>
+void BM_Suspensions(benchmark::State& state) {
+    auto service = MakeShared<Service>();
+    for (auto _ : state) {
+        auto task = kPinned ? service->Handle(state.range(0))
+                            : HandleWithCopies(service, state.range(0));
+        task.Resume();
+        while (!task.Done()) {
+            std::exchange(parked, nullptr).resume();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Nested(benchmark::State& state) {
+    for (auto _ : state) {
+        auto task = Nested(state.range(0));
+        task.Resume();
+    }
+    state.SetItemsProcessed(state.iterations() * (state.range(0) + 1));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SpawnEmpty, PinnedTask);
+BENCHMARK_TEMPLATE(BM_SpawnEmpty, HeapTask);
+
+BENCHMARK_TEMPLATE(BM_Suspensions, true)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_Suspensions, false)->Arg(1)->Arg(4)->Arg(16);
+
+BENCHMARK(BM_Nested)->Arg(1)->Arg(8)->Arg(64);
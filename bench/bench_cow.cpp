@@ -0,0 +1,58 @@
+#include "cow.h"
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+
+// Read-mostly config passed around by value: `Cow` vs a deep copy per pass.
+// `range(0)` out of every 1000 passes modify their copy.
+
+namespace {
+
+using Config = std::map<std::string, std::string>;
+
+Config MakeConfig() {
+    Config config;
+    for (int i = 0; i < 64; ++i) {
+        auto suffix = std::to_string(i);
+        config["key" + suffix] = "a value too long for the small string buffer " + suffix;
+    }
+    return config;
+}
+
+template <typename Holder>
+size_t Handle(Holder holder, int64_t pass, int64_t writes_per_mille) {
+    if (pass % 1000 < writes_per_mille) {
+        holder.Write()["key7"] = "changed";
+    }
+    return holder.Read().at("key7").size();
+}
+
+// Same interface over a plain value
+struct DeepCopy {
+    const Config& Read() const {
+        return config;
+    }
+
+    Config& Write() {
+        return config;
+    }
+
+    Config config;
+};
+
+template <typename Holder>
+void BM_PassByValue(benchmark::State& state) {
+    Holder holder{MakeConfig()};
+    int64_t pass = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Handle(holder, pass++, state.range(0)));
+    }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_PassByValue, DeepCopy)->Arg(0)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_PassByValue, Cow<Config>)->Arg(0)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_PassByValue, SyncCow<Config>)->Arg(0)->Arg(10)->Arg(100);
@@ -0,0 +1,178 @@
+#include "handle_table.h"
+#include "weak.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Resolving entity references in random order, and the heap each store needs per entity:
+// `HandleTable` vs `SharedPtr` owners with `WeakPtr`s in a hash map or an id-indexed vector
+
+namespace {
+
+struct Entity {
+    explicit Entity(int64_t id) : id(id) {
+    }
+
+    int64_t id;
+    double position[3] = {};
+};
+
+// Bytes requested through the global `operator new` below and not yet freed; allocator
+// headers and rounding are not included, so every platform reports the same numbers
+std::atomic<size_t> heap_in_use = 0;
+
+size_t HeapInUse() {
+    return heap_in_use.load(std::memory_order_relaxed);
+}
+
+struct TableStore {
+    using Key = GenerationalHandle;
+
+    Key Insert(int64_t id) {
+        return table.Insert(id);
+    }
+
+    Entity* Resolve(Key key) const {
+        return table.Resolve(key);
+    }
+
+    SharedPtr<Entity> Lock(Key key) const {
+        return table.Lock(key);
+    }
+
+    HandleTable<Entity> table;
+};
+
+struct WeakMapStore {
+    using Key = uint64_t;
+
+    Key Insert(int64_t id) {
+        owners.push_back(MakeShared<Entity>(id));
+        refs.emplace(id, owners.back());
+        return id;
+    }
+
+    Entity* Resolve(Key key) const {
+        return Lock(key).Get();
+    }
+
+    SharedPtr<Entity> Lock(Key key) const {
+        auto it = refs.find(key);
+        return it == refs.end() ? SharedPtr<Entity>() : it->second.Lock();
+    }
+
+    std::vector<SharedPtr<Entity>> owners;
+    std::unordered_map<uint64_t, WeakPtr<Entity>> refs;
+};
+
+struct WeakVectorStore {
+    using Key = uint64_t;
+
+    Key Insert(int64_t id) {
+        owners.push_back(MakeShared<Entity>(id));
+        refs.push_back(owners.back());
+        return id;
+    }
+
+    Entity* Resolve(Key key) const {
+        return Lock(key).Get();
+    }
+
+    SharedPtr<Entity> Lock(Key key) const {
+        return key < refs.size() ? refs[key].Lock() : SharedPtr<Entity>();
+    }
+
+    std::vector<SharedPtr<Entity>> owners;
+    std::vector<WeakPtr<Entity>> refs;
+};
+
+// Fills `store` with `count` entities, reports its heap use and returns the keys shuffled
+template <typename Store>
+std::vector<typename Store::Key> Fill(Store& store, benchmark::State& state) {
+    int64_t count = state.range(0);
+    size_t before = HeapInUse();
+    std::vector<typename Store::Key> keys;
+    for (int64_t i = 0; i < count; ++i) {
+        keys.push_back(store.Insert(i));
+    }
+    state.counters["bytes_per_entity"] =
+        static_cast<double>(HeapInUse() - before - keys.capacity() * sizeof(keys[0])) / count;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+    return keys;
+}
+
+template <typename Store>
+void BM_Resolve(benchmark::State& state) {
+    Store store;
+    auto keys = Fill(store, state);
+    for (auto _ : state) {
+        for (auto key : keys) {
+            benchmark::DoNotOptimize(store.Resolve(key)->id);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Store>
+void BM_Lock(benchmark::State& state) {
+    Store store;
+    auto keys = Fill(store, state);
+    for (auto _ : state) {
+        for (auto key : keys) {
+            auto locked = store.Lock(key);
+            benchmark::DoNotOptimize(locked->id);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+}  // namespace
+
+// Every allocation carries its size in a header, so frees can be counted too
+constexpr size_t kHeader = alignof(std::max_align_t);
+
+// GCC pairs the `free` below with `new` expressions inlined into it
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size) {
+    auto block = static_cast<char*>(std::malloc(size + kHeader));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    heap_in_use.fetch_add(size, std::memory_order_relaxed);
+    return block + kHeader;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    auto block = static_cast<char*>(ptr) - kHeader;
+    heap_in_use.fetch_sub(*reinterpret_cast<size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+#pragma GCC diagnostic pop
+
+BENCHMARK_TEMPLATE(BM_Resolve, TableStore)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Resolve, WeakMapStore)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Resolve, WeakVectorStore)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_Lock, TableStore)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Lock, WeakMapStore)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Lock, WeakVectorStore)->Range(1 << 10, 1 << 20);
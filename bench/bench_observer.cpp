@@ -0,0 +1,124 @@
+#include "observer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Publish latency with 10k subscribers: `ObserverList` vs a mutex around a vector of
+// `SyncWeakPtr`s. Every publish is followed by `range(1)` churn operations, each of
+// which subscribes a new observer and drops an older one.
+
+namespace {
+
+struct Subscriber {
+    std::atomic<long> events = 0;
+};
+
+// The baseline: publishers lock, promote and compact dead entries in place
+class MutexObserverList {
+public:
+    void Subscribe(SyncWeakPtr<Subscriber> observer) {
+        std::lock_guard guard(mutex_);
+        observers_.push_back(std::move(observer));
+    }
+
+    template <typename F>
+    size_t Publish(F&& f) {
+        std::lock_guard guard(mutex_);
+        size_t delivered = 0;
+        auto alive = observers_.begin();
+        for (auto& observer : observers_) {
+            if (auto locked = observer.Lock()) {
+                f(*locked);
+                ++delivered;
+                *alive++ = std::move(observer);
+            }
+        }
+        observers_.erase(alive, observers_.end());
+        return delivered;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<SyncWeakPtr<Subscriber>> observers_;
+};
+
+template <typename List>
+struct Fixture {
+    explicit Fixture(size_t subscribers) {
+        for (size_t i = 0; i < subscribers; ++i) {
+            owners.push_back(MakeSyncShared<Subscriber>());
+            list.Subscribe(owners.back());
+        }
+        list.Publish([](Subscriber&) {});
+    }
+
+    List list;
+    std::vector<SyncSharedPtr<Subscriber>> owners;
+};
+
+template <typename List>
+void BM_Publish(benchmark::State& state) {
+    static Fixture<List>* fixture = nullptr;
+    if (state.thread_index() == 0) {
+        fixture = new Fixture<List>(state.range(0));
+    }
+    // Each thread replaces only its own subscribers
+    std::vector<SyncSharedPtr<Subscriber>> churn(64);
+    size_t next = 0;
+    std::vector<double> latencies;
+    latencies.reserve(1 << 16);
+    for (auto _ : state) {
+        auto start = std::chrono::steady_clock::now();
+        auto delivered = fixture->list.Publish([](Subscriber& subscriber) {
+            subscriber.events.fetch_add(1, std::memory_order_relaxed);
+        });
+        auto finish = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(delivered);
+        if (latencies.size() < latencies.capacity()) {
+            latencies.push_back(std::chrono::duration<double, std::micro>(finish - start).count());
+        }
+        for (int64_t i = 0; i < state.range(1); ++i) {
+            auto& slot = churn[next++ % churn.size()];
+            slot = MakeSyncShared<Subscriber>();
+            fixture->list.Subscribe(slot);
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    if (!latencies.empty()) {
+        auto percentile = [&](size_t p) {
+            return benchmark::Counter(latencies[latencies.size() * p / 100],
+                                      benchmark::Counter::kAvgThreads);
+        };
+        state.counters["p50_us"] = percentile(50);
+        state.counters["p99_us"] = percentile(99);
+    }
+    churn.clear();
+    if (state.thread_index() == 0) {
+        delete std::exchange(fixture, nullptr);
+    }
+}
+
+void PublishArgs(benchmark::internal::Benchmark* bench) {
+    for (int64_t churn : {0, 16, 256}) {
+        bench->Args({10000, churn});
+    }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Publish, ObserverList<Subscriber>)->Apply(PublishArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Publish, MutexObserverList)->Apply(PublishArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Publish, ObserverList<Subscriber>)
+    ->Args({10000, 16})
+    ->ThreadRange(2, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Publish, MutexObserverList)
+    ->Args({10000, 16})
+    ->ThreadRange(2, 8)
+    ->UseRealTime();
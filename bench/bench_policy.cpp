@@ -0,0 +1,113 @@
+#include "shared.h"
+#include "weak.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+// One row per counting policy and storage, with std::shared_ptr as the reference
+
+namespace {
+
+struct Payload {
+    long value = 0;
+};
+
+// Object and control block allocated separately
+struct SeparateStorage {
+    template <typename T, typename CountPolicy>
+    static BasicSharedPtr<T, CountPolicy> Make() {
+        return BasicSharedPtr<T, CountPolicy>(new T);
+    }
+};
+
+// Object stored inside the control block
+struct InlineStorage {
+    template <typename T, typename CountPolicy>
+    static BasicSharedPtr<T, CountPolicy> Make() {
+        return MakeBasicShared<T, CountPolicy>();
+    }
+};
+
+template <typename CountPolicy, typename Storage>
+void BM_Create(benchmark::State& state) {
+    for (auto _ : state) {
+        auto ptr = Storage::template Make<Payload, CountPolicy>();
+        benchmark::DoNotOptimize(ptr.Get());
+    }
+}
+
+template <typename CountPolicy, typename Storage>
+void BM_Copy(benchmark::State& state) {
+    auto ptr = Storage::template Make<Payload, CountPolicy>();
+    for (auto _ : state) {
+        auto copy = ptr;
+        benchmark::DoNotOptimize(copy.Get());
+    }
+}
+
+template <typename CountPolicy, typename Storage>
+void BM_Lock(benchmark::State& state) {
+    auto ptr = Storage::template Make<Payload, CountPolicy>();
+    BasicWeakPtr<Payload, CountPolicy> weak = ptr;
+    for (auto _ : state) {
+        auto locked = weak.Lock();
+        benchmark::DoNotOptimize(locked.Get());
+    }
+}
+
+// Every thread copies the same handle
+template <typename Storage>
+void BM_CopyContended(benchmark::State& state) {
+    static auto ptr = Storage::template Make<Payload, AtomicCount>();
+    for (auto _ : state) {
+        auto copy = ptr;
+        benchmark::DoNotOptimize(copy.Get());
+    }
+}
+
+void BM_StdCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        auto ptr = std::make_shared<Payload>();
+        benchmark::DoNotOptimize(ptr.get());
+    }
+}
+
+void BM_StdCopy(benchmark::State& state) {
+    auto ptr = std::make_shared<Payload>();
+    for (auto _ : state) {
+        auto copy = ptr;
+        benchmark::DoNotOptimize(copy.get());
+    }
+}
+
+void BM_StdCopyContended(benchmark::State& state) {
+    static auto ptr = std::make_shared<Payload>();
+    for (auto _ : state) {
+        auto copy = ptr;
+        benchmark::DoNotOptimize(copy.get());
+    }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Create, SingleThreadedCount, SeparateStorage);
+BENCHMARK_TEMPLATE(BM_Create, SingleThreadedCount, InlineStorage);
+BENCHMARK_TEMPLATE(BM_Create, AtomicCount, SeparateStorage);
+BENCHMARK_TEMPLATE(BM_Create, AtomicCount, InlineStorage);
+BENCHMARK(BM_StdCreate);
+
+BENCHMARK_TEMPLATE(BM_Copy, SingleThreadedCount, SeparateStorage);
+BENCHMARK_TEMPLATE(BM_Copy, SingleThreadedCount, InlineStorage);
+BENCHMARK_TEMPLATE(BM_Copy, AtomicCount, SeparateStorage);
+BENCHMARK_TEMPLATE(BM_Copy, AtomicCount, InlineStorage);
+BENCHMARK(BM_StdCopy);
+
+BENCHMARK_TEMPLATE(BM_Lock, SingleThreadedCount, SeparateStorage);
+BENCHMARK_TEMPLATE(BM_Lock, SingleThreadedCount, InlineStorage);
+BENCHMARK_TEMPLATE(BM_Lock, AtomicCount, SeparateStorage);
+BENCHMARK_TEMPLATE(BM_Lock, AtomicCount, InlineStorage);
+
+BENCHMARK_TEMPLATE(BM_CopyContended, SeparateStorage)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CopyContended, InlineStorage)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_StdCopyContended)->ThreadRange(1, 8)->UseRealTime();
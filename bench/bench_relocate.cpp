@@ -0,0 +1,99 @@
+#include "relocate.h"
+
+#include <benchmark/benchmark.h>
+
+#include <utility>
+#include <vector>
+
+// Growth and front erase of `UniquePtr` and `SharedPtr` elements:
+// `std::vector` (element-wise moves) vs `RelocatingVector` (memcpy/memmove)
+
+namespace {
+
+template <typename Ptr>
+Ptr MakeElement(int value) {
+    if constexpr (std::is_same_v<Ptr, UniquePtr<int>>) {
+        return Ptr(new int(value));
+    } else {
+        return MakeShared<int>(value);
+    }
+}
+
+template <typename Vector, typename Ptr>
+void Push(Vector& vector, Ptr&& ptr) {
+    if constexpr (requires { vector.PushBack(std::move(ptr)); }) {
+        vector.PushBack(std::move(ptr));
+    } else {
+        vector.push_back(std::move(ptr));
+    }
+}
+
+template <typename Vector>
+void EraseFront(Vector& vector) {
+    if constexpr (requires { vector.Erase(vector.begin()); }) {
+        vector.Erase(vector.begin());
+    } else {
+        vector.erase(vector.begin());
+    }
+}
+
+// Elements are made up front, so only the pushes and reallocations are timed
+template <typename Vector, typename Ptr>
+void BM_Growth(benchmark::State& state) {
+    std::vector<Ptr> elements;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        elements.push_back(MakeElement<Ptr>(i));
+    }
+    for (auto _ : state) {
+        Vector vector;
+        for (auto& element : elements) {
+            Push(vector, std::move(element));
+        }
+        benchmark::DoNotOptimize(&vector);
+        state.PauseTiming();
+        for (size_t i = 0; i < elements.size(); ++i) {
+            elements[i] = std::move(vector[i]);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Erases the first element `range(0) / 16` times
+template <typename Vector, typename Ptr>
+void BM_EraseFront(benchmark::State& state) {
+    int64_t erases = state.range(0) / 16;
+    Vector vector;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        Push(vector, MakeElement<Ptr>(i));
+    }
+    for (auto _ : state) {
+        for (int64_t i = 0; i < erases; ++i) {
+            EraseFront(vector);
+        }
+        state.PauseTiming();
+        for (int64_t i = 0; i < erases; ++i) {
+            Push(vector, MakeElement<Ptr>(i));
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * erases);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Growth, std::vector<UniquePtr<int>>, UniquePtr<int>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Growth, RelocatingVector<UniquePtr<int>>, UniquePtr<int>)
+    ->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Growth, std::vector<SharedPtr<int>>, SharedPtr<int>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Growth, RelocatingVector<SharedPtr<int>>, SharedPtr<int>)
+    ->Range(1 << 10, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_EraseFront, std::vector<UniquePtr<int>>, UniquePtr<int>)
+    ->Range(1 << 10, 1 << 14);
+BENCHMARK_TEMPLATE(BM_EraseFront, RelocatingVector<UniquePtr<int>>, UniquePtr<int>)
+    ->Range(1 << 10, 1 << 14);
+BENCHMARK_TEMPLATE(BM_EraseFront, std::vector<SharedPtr<int>>, SharedPtr<int>)
+    ->Range(1 << 10, 1 << 14);
+BENCHMARK_TEMPLATE(BM_EraseFront, RelocatingVector<SharedPtr<int>>, SharedPtr<int>)
+    ->Range(1 << 10, 1 << 14);
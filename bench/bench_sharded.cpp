@@ -0,0 +1,44 @@
+#include "sharded.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+// Every thread copies, reads and drops the same global handle, as a request handler does
+// with the config: one `SyncSharedPtr` / `std::shared_ptr` count vs `ShardedSharedPtr`
+
+namespace {
+
+struct Config {
+    long value = 0;
+};
+
+template <typename Ptr>
+const Ptr& Global() {
+    static const Ptr ptr = [] {
+        if constexpr (std::is_same_v<Ptr, ShardedSharedPtr<Config>>) {
+            return MakeShardedShared<Config>();
+        } else if constexpr (std::is_same_v<Ptr, SyncSharedPtr<Config>>) {
+            return MakeSyncShared<Config>();
+        } else {
+            return std::make_shared<Config>();
+        }
+    }();
+    return ptr;
+}
+
+template <typename Ptr>
+void BM_CopyScaling(benchmark::State& state) {
+    const auto& global = Global<Ptr>();
+    for (auto _ : state) {
+        auto copy = global;
+        benchmark::DoNotOptimize(copy->value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_CopyScaling, SyncSharedPtr<Config>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CopyScaling, std::shared_ptr<Config>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CopyScaling, ShardedSharedPtr<Config>)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,54 @@
+#include "unique.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// `std::vector` growth for `UniquePtr` elements and for a struct that holds one next to
+// a copyable member, which the vector only moves if the whole move is noexcept
+
+namespace {
+
+template <typename Ptr>
+struct Holder {
+    Ptr ptr;
+    std::string name;
+};
+
+template <typename Element>
+Element MakeElement(int value) {
+    if constexpr (std::is_same_v<Element, UniquePtr<int>> ||
+                  std::is_same_v<Element, std::unique_ptr<int>>) {
+        return Element(new int(value));
+    } else {
+        return Element{decltype(Element::ptr)(new int(value)), std::string(32, 'x')};
+    }
+}
+
+template <typename Element>
+void BM_Growth(benchmark::State& state) {
+    std::vector<Element> elements;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        elements.push_back(MakeElement<Element>(i));
+    }
+    for (auto _ : state) {
+        std::vector<Element> vector;
+        for (auto& element : elements) {
+            vector.push_back(std::move(element));
+        }
+        benchmark::DoNotOptimize(vector.data());
+        state.PauseTiming();
+        elements = std::move(vector);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Growth, UniquePtr<int>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Growth, std::unique_ptr<int>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Growth, Holder<UniquePtr<int>>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Growth, Holder<std::unique_ptr<int>>)->Range(1 << 10, 1 << 16);
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "shared.h"
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Control blocks
+
+// Bytes follow the block in the same allocation
+template <typename CountPolicy>
+struct ByteBufferControlBlock : BasicControlBlock<CountPolicy> {
+    // Only the header is accounted for, payload bytes are not overhead
+    static ByteBufferControlBlock* Create(size_t size) {
+        auto memory = ::operator new(sizeof(ByteBufferControlBlock) + size);
+        ControlBlockTally::Add(sizeof(ByteBufferControlBlock));
+        return ::new (memory) ByteBufferControlBlock;
+    }
+
+    std::byte* Data() {
+        return reinterpret_cast<std::byte*>(this + 1);
+    }
+
+    void OnZeroShared() override {
+    }
+
+    void OnZeroWeak() override {
+        this->~ByteBufferControlBlock();
+        ControlBlockTally::Remove(sizeof(ByteBufferControlBlock));
+        ::operator delete(this);
+    }
+};
+
+// Foreign bytes released by `deleter(data, size)`
+template <typename Deleter, typename CountPolicy>
+struct AdoptedBufferControlBlock : BasicControlBlock<CountPolicy> {
+    AdoptedBufferControlBlock(std::byte* data, size_t size, Deleter deleter)
+        : data_(data), size_(size), deleter_(std::move(deleter)) {
+    }
+
+    void OnZeroShared() override {
+        deleter_(data_, size_);
+    }
+
+    void OnZeroWeak() override {
+        delete this;
+    }
+
+    std::byte* data_;
+    size_t size_;
+    [[no_unique_address]] Deleter deleter_;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Slices
+
+// Read-only view into a shared buffer; copying and slicing share ownership without copying bytes
+template <typename CountPolicy = SingleThreadedCount>
+class BasicSharedSlice {
+public:
+    BasicSharedSlice() {
+    }
+
+    BasicSharedSlice(BasicSharedPtr<const std::byte, CountPolicy> data, size_t size)
+        : data_(std::move(data)), size_(size) {
+    }
+
+    BasicSharedSlice Slice(size_t offset, size_t size) const {
+        if (offset > size_ || size > size_ - offset) {
+            throw std::out_of_range("SharedSlice::Slice");
+        }
+        return BasicSharedSlice(BasicSharedPtr<const std::byte, CountPolicy>(data_, Data() + offset),
+                                size);
+    }
+
+    BasicSharedSlice Slice(size_t offset) const {
+        if (offset > size_) {
+            throw std::out_of_range("SharedSlice::Slice");
+        }
+        return Slice(offset, size_ - offset);
+    }
+
+    const std::byte* Data() const {
+        return data_.Get();
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return !size_;
+    }
+
+    const std::byte& operator[](size_t i) const {
+        return data_.Get()[i];
+    }
+
+    std::string_view AsStringView() const {
+        return std::string_view(reinterpret_cast<const char*>(Data()), size_);
+    }
+
+    const BasicSharedPtr<const std::byte, CountPolicy>& GetOwner() const {
+        return data_;
+    }
+
+private:
+    BasicSharedPtr<const std::byte, CountPolicy> data_;
+    size_t size_ = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Buffers
+
+// Writable byte buffer; hand out `SharedSlice`s once it is filled
+template <typename CountPolicy>
+class BasicSharedBuffer {
+public:
+    BasicSharedBuffer() {
+    }
+
+    // Control block and bytes in one allocation, bytes left uninitialized
+    static BasicSharedBuffer Allocate(size_t size) {
+        auto block = ByteBufferControlBlock<CountPolicy>::Create(size);
+        return BasicSharedBuffer(BasicSharedPtr<std::byte, CountPolicy>(block->Data(), block), size);
+    }
+
+    // Takes ownership of `data`; `deleter(data, size)` runs when the last slice is gone,
+    // or right away if the control block cannot be allocated
+    template <typename Deleter>
+    static BasicSharedBuffer Adopt(std::byte* data, size_t size, Deleter deleter) {
+        AdoptedBufferControlBlock<Deleter, CountPolicy>* block;
+        try {
+            // The block is allocated before `deleter` is moved from
+            block = new AdoptedBufferControlBlock<Deleter, CountPolicy>(data, size,
+                                                                        std::move(deleter));
+        } catch (...) {
+            deleter(data, size);
+            throw;
+        }
+        return BasicSharedBuffer(BasicSharedPtr<std::byte, CountPolicy>(data, block), size);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Read-only private mapping of the whole file, unmapped with the last slice
+    static BasicSharedBuffer MapFile(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        size_t size = st.st_size;
+        if (!size) {
+            ::close(fd);
+            return BasicSharedBuffer();
+        }
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        int error = errno;
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        return Adopt(static_cast<std::byte*>(data), size,
+                     [](std::byte* data, size_t size) { ::munmap(data, size); });
+    }
+#endif
+
+    BasicSharedSlice<CountPolicy> Slice(size_t offset, size_t size) const {
+        return AsSlice().Slice(offset, size);
+    }
+
+    BasicSharedSlice<CountPolicy> Slice(size_t offset) const {
+        return AsSlice().Slice(offset);
+    }
+
+    BasicSharedSlice<CountPolicy> AsSlice() const {
+        return BasicSharedSlice<CountPolicy>(data_, size_);
+    }
+
+    std::byte* Data() const {
+        return data_.Get();
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return !size_;
+    }
+
+    std::byte& operator[](size_t i) const {
+        return data_.Get()[i];
+    }
+
+private:
+    BasicSharedBuffer(BasicSharedPtr<std::byte, CountPolicy> data, size_t size)
+        : data_(std::move(data)), size_(size) {
+    }
+
+    BasicSharedPtr<std::byte, CountPolicy> data_;
+    size_t size_ = 0;
+};
+
+using SharedSlice = BasicSharedSlice<>;
+using SharedBuffer = BasicSharedBuffer<>;
+
+using SyncSharedSlice = BasicSharedSlice<AtomicCount>;
+using SyncSharedBuffer = BasicSharedBuffer<AtomicCount>;
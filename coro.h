@@ -0,0 +1,285 @@
+#pragma once
+
+#include "shared.h"
+#include "unique.h"
+#include "weak.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Frame pool
+
+// Per-thread free lists of coroutine frames in 64-byte size classes. A frame freed on
+// another thread joins that thread's lists; larger frames go straight to the heap.
+class FramePool {
+public:
+    static constexpr size_t kGranularity = 64;
+    static constexpr size_t kClasses = 32;
+    static constexpr size_t kMaxCached = 64;
+
+    static void* Allocate(size_t size) {
+        size_t index = ClassOf(size);
+        if (index < kClasses) {
+            auto& list = Local().lists[index];
+            if (list.head) {
+                --list.size;
+                return std::exchange(list.head, list.head->next);
+            }
+            return ::operator new((index + 1) * kGranularity);
+        }
+        return ::operator new(size);
+    }
+
+    static void Deallocate(void* ptr, size_t size) {
+        size_t index = ClassOf(size);
+        if (index < kClasses) {
+            auto& list = Local().lists[index];
+            if (list.size < kMaxCached) {
+                list.head = ::new (ptr) Node{list.head};
+                ++list.size;
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    struct List {
+        Node* head = nullptr;
+        size_t size = 0;
+    };
+
+    struct Lists {
+        ~Lists() {
+            for (auto& list : lists) {
+                while (list.head) {
+                    ::operator delete(std::exchange(list.head, list.head->next));
+                }
+                list.size = kMaxCached;
+            }
+        }
+
+        List lists[kClasses];
+    };
+
+    static size_t ClassOf(size_t size) {
+        return (size + kGranularity - 1) / kGranularity - 1;
+    }
+
+    static Lists& Local() {
+        thread_local Lists lists;
+        return lists;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Task
+
+// Lazily started coroutine task. When the coroutine is a member function of a type deriving
+// from `EnableSharedFromThis`, or its first parameter is such an object or a pointer to one,
+// the promise takes one `SharedFromThis()` reference at creation and drops it at completion,
+// so the object outlives every suspension without per-`co_await` copies. An object no
+// `SharedPtr` owns (on the stack, or still in its constructor) is simply not pinned, and
+// keeping it alive is up to the caller.
+// The frame is owned through `UniquePtr` and allocated from `FramePool`.
+template <typename CountPolicy = SingleThreadedCount>
+class BasicPinnedTask {
+public:
+    struct promise_type;
+
+    struct FrameDestroyer {
+        void operator()(promise_type* promise) const noexcept {
+            std::coroutine_handle<promise_type>::from_promise(*promise).destroy();
+        }
+    };
+
+    // Filled in at final suspension and owned by whoever waits for the task. Dropping the pin
+    // may destroy the object holding the task, and with it the frame, so the waiter never
+    // reads the promise once the coroutine has finished.
+    struct Completion {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+        bool finished = false;
+    };
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<promise_type> handle) const noexcept {
+            auto& promise = handle.promise();
+            Completion* completion = promise.completion;
+            if (completion) {
+                completion->exception = promise.exception;
+                completion->finished = true;
+            }
+            // `promise` may be gone after this
+            promise.pin.Reset();
+            if (completion && completion->continuation) {
+                return completion->continuation;
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {
+        }
+    };
+
+    struct promise_type {
+        promise_type() {
+        }
+
+        template <typename Self, typename... Args>
+        promise_type(Self& self, Args&...) {
+            Pin(self);
+        }
+
+        static void* operator new(size_t size) {
+            return FramePool::Allocate(size);
+        }
+
+        static void operator delete(void* ptr, size_t size) {
+            FramePool::Deallocate(ptr, size);
+        }
+
+        BasicPinnedTask get_return_object() {
+            return BasicPinnedTask(this);
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {
+        }
+
+        void unhandled_exception() {
+            exception = std::current_exception();
+        }
+
+        // Some compilers pass the implicit object parameter as `this` rather than `*this`
+        template <typename Self>
+        void Pin(Self& self) {
+            if constexpr (std::is_pointer_v<Self>) {
+                if (self) {
+                    Pin(*self);
+                }
+            } else if constexpr (std::is_base_of_v<EnableSharedFromThisBase, Self>) {
+                // Empty if no `SharedPtr` owns the object
+                pin = self.WeakFromThis().Lock();
+            }
+        }
+
+        BasicSharedPtr<const EnableSharedFromThisBase, CountPolicy> pin;
+        Completion* completion = nullptr;
+        std::exception_ptr exception;
+    };
+
+    // A default-constructed task has no frame and counts as done
+    struct Awaiter {
+        bool await_ready() noexcept {
+            if (!promise) {
+                return true;
+            }
+            if (Handle().done()) {
+                completion.exception = promise->exception;
+                return true;
+            }
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            completion.continuation = awaiting;
+            promise->completion = &completion;
+            return Handle();
+        }
+
+        void await_resume() const {
+            if (completion.exception) {
+                std::rethrow_exception(completion.exception);
+            }
+        }
+
+        std::coroutine_handle<promise_type> Handle() const {
+            return std::coroutine_handle<promise_type>::from_promise(*promise);
+        }
+
+        promise_type* promise;
+        Completion completion{};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Constructors
+
+    BasicPinnedTask() {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Modifiers
+
+    // Runs until the next suspension point; rethrows if the coroutine failed. Finishing can
+    // destroy this task along with the object it pins, so the outcome is read from a local.
+    void Resume() {
+        if (Done()) {
+            if (promise_ && promise_->exception) {
+                std::rethrow_exception(promise_->exception);
+            }
+            return;
+        }
+        auto handle = std::coroutine_handle<promise_type>::from_promise(*promise_);
+        if (promise_->completion) {
+            // Another coroutine is waiting for this one and receives the outcome
+            handle.resume();
+            return;
+        }
+        Completion completion;
+        promise_->completion = &completion;
+        handle.resume();
+        if (!completion.finished) {
+            promise_->completion = nullptr;
+        } else if (completion.exception) {
+            std::rethrow_exception(completion.exception);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Observers
+
+    bool Done() const {
+        return !promise_ || std::coroutine_handle<promise_type>::from_promise(*promise_).done();
+    }
+
+    // Whether the task still holds its `SharedFromThis()` reference
+    bool Pinned() const {
+        return promise_ && promise_->pin;
+    }
+
+    Awaiter operator co_await() const& noexcept {
+        return Awaiter{promise_.Get()};
+    }
+
+private:
+    explicit BasicPinnedTask(promise_type* promise) : promise_(promise) {
+    }
+
+    UniquePtr<promise_type, FrameDestroyer> promise_;
+};
+
+using PinnedTask = BasicPinnedTask<>;
+
+using SyncPinnedTask = BasicPinnedTask<AtomicCount>;
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "shared.h"
+
+#include <utility>
+
+// Copy-on-write value: copies share one object, and the first mutable access through
+// a shared copy clones it. The handle is never exposed, so no `WeakPtr` can race with
+// the uniqueness check.
+// A moved-from `Cow` may only be assigned to or destroyed.
+template <typename T, typename CountPolicy = SingleThreadedCount>
+class BasicCow {
+public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Constructors
+
+    BasicCow() : ptr_(MakeBasicShared<T, CountPolicy>()) {
+    }
+
+    BasicCow(const T& value) : ptr_(MakeBasicShared<T, CountPolicy>(value)) {
+    }
+
+    BasicCow(T&& value) : ptr_(MakeBasicShared<T, CountPolicy>(std::move(value))) {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Access
+
+    const T& Read() const {
+        return *ptr_;
+    }
+
+    const T& operator*() const {
+        return *ptr_;
+    }
+
+    const T* operator->() const {
+        return ptr_.Get();
+    }
+
+    // Clones the object unless this is its only owner
+    T& Write() {
+        if (!ptr_.IsUnique()) {
+            ptr_ = MakeBasicShared<T, CountPolicy>(std::as_const(*ptr_));
+        }
+        return *ptr_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Observers
+
+    bool IsShared() const {
+        return !ptr_.IsUnique();
+    }
+
+    size_t UseCount() const {
+        return ptr_.UseCount();
+    }
+
+private:
+    BasicSharedPtr<T, CountPolicy> ptr_;
+};
+
+template <typename T>
+using Cow = BasicCow<T>;
+
+template <typename T>
+using SyncCow = BasicCow<T, AtomicCount>;
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "shared.h"
+#include "unique.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 32-bit slot index and 32-bit generation packed into one word
+struct GenerationalHandle {
+    static constexpr GenerationalHandle FromParts(uint32_t index, uint32_t generation) {
+        return GenerationalHandle{(static_cast<uint64_t>(generation) << 32) | index};
+    }
+
+    constexpr uint32_t Index() const {
+        return static_cast<uint32_t>(value);
+    }
+
+    constexpr uint32_t Generation() const {
+        return static_cast<uint32_t>(value >> 32);
+    }
+
+    constexpr explicit operator bool() const {
+        return value != 0;
+    }
+
+    friend constexpr bool operator==(GenerationalHandle left, GenerationalHandle right) {
+        return left.value == right.value;
+    }
+
+    uint64_t value = 0;
+};
+
+// Objects stored in place in dense, address-stable slots, each of which is also the
+// object's control block. Handles resolve in O(1) while the object is alive, like a
+// `WeakPtr` without its own allocation or count.
+//
+// The table holds one reference to every object until `Erase()`; `SharedPtr`s from
+// `Lock()` can keep it alive past that. The object is destroyed and the generation
+// bumped in `OnZeroShared`, the slot is reused after `OnZeroWeak`.
+// Not thread-safe, and the table must outlive every `SharedPtr` it hands out.
+template <typename T>
+class HandleTable {
+public:
+    static constexpr size_t kChunkSize = 1024;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Constructors
+
+    HandleTable() {
+    }
+
+    HandleTable(const HandleTable&) = delete;
+    HandleTable& operator=(const HandleTable&) = delete;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Destructor
+
+    ~HandleTable() {
+        for (auto& chunk : chunks_) {
+            for (size_t i = 0; i < kChunkSize; ++i) {
+                auto& slot = chunk[i];
+                if (slot.owned) {
+                    slot.owned = false;
+                    slot.DecrementShared();
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Modifiers
+
+    template <typename... Args>
+    GenerationalHandle Insert(Args&&... args) {
+        if (free_ == kNoSlot) {
+            Grow();
+        }
+        auto& slot = At(free_);
+        new (&slot.storage) T(std::forward<Args>(args)...);
+        free_ = slot.next_free;
+        slot.shared_count_ = 1;
+        slot.weak_count_ = 1;
+        slot.owned = true;
+        ++size_;
+        return GenerationalHandle::FromParts(slot.index, slot.generation);
+    }
+
+    // Drops the table's reference; returns false if `handle` is stale or already erased
+    bool Erase(GenerationalHandle handle) {
+        auto slot = Find(handle);
+        if (!slot || !slot->owned) {
+            return false;
+        }
+        slot->owned = false;
+        --size_;
+        slot->DecrementShared();
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Observers
+
+    // Valid until the object loses its last owner
+    T* Resolve(GenerationalHandle handle) const {
+        auto slot = Find(handle);
+        return slot ? slot->GetRawPtr() : nullptr;
+    }
+
+    SharedPtr<T> Lock(GenerationalHandle handle) const {
+        auto slot = Find(handle);
+        if (!slot || !slot->IncrementSharedIfNotZero()) {
+            return SharedPtr<T>();
+        }
+        return SharedPtr<T>(slot->GetRawPtr(), slot);
+    }
+
+    bool Contains(GenerationalHandle handle) const {
+        return Find(handle) != nullptr;
+    }
+
+    // Objects inserted and not yet erased
+    size_t Size() const {
+        return size_;
+    }
+
+    size_t Capacity() const {
+        return chunks_.size() * kChunkSize;
+    }
+
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    struct Slot : ControlBlock {
+        T* GetRawPtr() {
+            return reinterpret_cast<T*>(&storage);
+        }
+
+        void OnZeroShared() override {
+            GetRawPtr()->~T();
+            // Generation 0 is skipped, so a handle to index 0 never equals the null handle
+            if (!++generation) {
+                generation = 1;
+            }
+        }
+
+        void OnZeroWeak() override {
+            next_free = table->free_;
+            table->free_ = index;
+        }
+
+        HandleTable* table = nullptr;
+        uint32_t index = 0;
+        uint32_t generation = 1;
+        uint32_t next_free = kNoSlot;
+        bool owned = false;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    };
+
+    Slot& At(uint32_t index) const {
+        return chunks_[index / kChunkSize][index % kChunkSize];
+    }
+
+    Slot* Find(GenerationalHandle handle) const {
+        uint32_t index = handle.Index();
+        if (index >= Capacity()) {
+            return nullptr;
+        }
+        auto& slot = At(index);
+        if (slot.generation != handle.Generation() || !slot.SharedCount()) {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    void Grow() {
+        uint32_t base = chunks_.size() * kChunkSize;
+        UniquePtr<Slot[]> chunk(new Slot[kChunkSize]);
+        chunks_.emplace_back(std::move(chunk));
+        for (uint32_t i = kChunkSize; i-- > 0;) {
+            auto& slot = At(base + i);
+            slot.table = this;
+            slot.index = base + i;
+            slot.shared_count_ = 0;
+            slot.weak_count_ = 0;
+            slot.next_free = free_;
+            free_ = base + i;
+        }
+    }
+
+    std::vector<UniquePtr<Slot[]>> chunks_;
+    uint32_t free_ = kNoSlot;
+    size_t size_ = 0;
+};
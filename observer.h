@@ -0,0 +1,284 @@
+#pragma once
+
+#include "shared.h"
+#include "unique.h"
+#include "weak.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Weakly held subscribers for fan-out across threads.
+//
+// `Publish()` is lock-free and walks an immutable snapshot of the entries, promoting
+// each one with `Lock()`. `Subscribe()` and `Subscription::Unsubscribe()` are wait-free:
+// new entries go to a queue and removals only flag the entry. Whichever publisher finds
+// enough queued or dead entries folds them into a fresh snapshot; the others never wait
+// for it. Replaced snapshots are reclaimed by epochs: a publisher registers under the
+// current epoch, the epoch advances only once the previous one has no publishers left,
+// and a snapshot retired in epoch E is freed once the epoch reaches E + 2.
+template <typename T>
+class ObserverList {
+    struct Entry {
+        explicit Entry(SyncWeakPtr<T> observer) : observer(std::move(observer)) {
+        }
+
+        SyncWeakPtr<T> observer;
+        std::atomic<bool> active = true;
+    };
+
+public:
+    class Subscription {
+    public:
+        Subscription() {
+        }
+
+        void Unsubscribe() {
+            if (entry_) {
+                entry_->active.store(false, std::memory_order_release);
+            }
+        }
+
+        bool Active() const {
+            return entry_ && entry_->active.load(std::memory_order_acquire) &&
+                   !entry_->observer.Expired();
+        }
+
+    private:
+        explicit Subscription(SyncSharedPtr<Entry> entry) : entry_(std::move(entry)) {
+        }
+
+        SyncSharedPtr<Entry> entry_;
+
+        friend class ObserverList;
+    };
+
+    static constexpr size_t kMinDeadToCompact = 32;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Constructors
+
+    ObserverList() : current_(new Snapshot) {
+    }
+
+    ObserverList(const ObserverList&) = delete;
+    ObserverList& operator=(const ObserverList&) = delete;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Destructor
+
+    // No other thread may be using the list
+    ~ObserverList() {
+        delete current_.load();
+        while (retired_) {
+            delete std::exchange(retired_, retired_->next_retired);
+        }
+        while (auto node = Pop()) {
+            delete node;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Modifiers
+
+    // Visible to publishers after the next compaction
+    Subscription Subscribe(SyncWeakPtr<T> observer) {
+        auto entry = MakeSyncShared<Entry>(std::move(observer));
+        auto node = new PendingNode;
+        node->entry = entry;
+        Push(node);
+        pending_.fetch_add(1, std::memory_order_release);
+        return Subscription(std::move(entry));
+    }
+
+    // Calls `f(T&)` for every live subscriber, returns how many were called
+    template <typename F>
+    size_t Publish(F&& f) {
+        size_t delivered = 0;
+        size_t dead = 0;
+        size_t size = 0;
+        {
+            ReadGuard guard(*this);
+            size = guard.snapshot->entries.size();
+            for (const auto& entry : guard.snapshot->entries) {
+                if (!entry->active.load(std::memory_order_acquire)) {
+                    ++dead;
+                    continue;
+                }
+                if (auto observer = entry->observer.Lock()) {
+                    f(*observer);
+                    ++delivered;
+                } else {
+                    ++dead;
+                }
+            }
+        }
+        bool compact_dead = dead >= std::max(kMinDeadToCompact, size / 8);
+        if (compact_dead || pending_.load(std::memory_order_relaxed) ||
+            retired_count_.load(std::memory_order_relaxed)) {
+            TryMaintain(compact_dead);
+        }
+        return delivered;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Observers
+
+    // Entries in the current snapshot, including dead ones not compacted yet
+    size_t SnapshotSize() const {
+        ReadGuard guard(*this);
+        return guard.snapshot->entries.size();
+    }
+
+private:
+    struct Snapshot {
+        std::vector<SyncSharedPtr<Entry>> entries;
+        uint64_t retired_epoch = 0;
+        Snapshot* next_retired = nullptr;
+    };
+
+    struct PendingNode {
+        std::atomic<PendingNode*> next = nullptr;
+        SyncSharedPtr<Entry> entry;
+    };
+
+    struct ReadGuard {
+        explicit ReadGuard(const ObserverList& list) : list(list) {
+            for (;;) {
+                epoch = list.epoch_.load();
+                list.readers_[epoch & 1].fetch_add(1);
+                if (list.epoch_.load() == epoch) {
+                    break;
+                }
+                list.readers_[epoch & 1].fetch_sub(1);
+            }
+            snapshot = list.current_.load();
+        }
+
+        ~ReadGuard() {
+            list.readers_[epoch & 1].fetch_sub(1);
+        }
+
+        const ObserverList& list;
+        uint64_t epoch;
+        const Snapshot* snapshot;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Pending queue (intrusive MPSC queue with a stub node)
+
+    void Push(PendingNode* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = tail_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer side, returns nullptr if empty or a producer is mid-push
+    PendingNode* Pop() {
+        auto head = head_;
+        auto next = head->next.load(std::memory_order_acquire);
+        if (head == &stub_) {
+            if (!next) {
+                return nullptr;
+            }
+            head_ = next;
+            head = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            head_ = next;
+            return head;
+        }
+        if (tail_.load(std::memory_order_acquire) != head) {
+            return nullptr;
+        }
+        Push(&stub_);
+        next = head->next.load(std::memory_order_acquire);
+        if (next) {
+            head_ = next;
+            return head;
+        }
+        return nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Maintenance, run by one publisher at a time
+
+    void TryMaintain(bool compact_dead) {
+        if (maintaining_.exchange(true, std::memory_order_acquire)) {
+            return;
+        }
+        struct Unlock {
+            ~Unlock() {
+                flag.store(false, std::memory_order_release);
+            }
+            std::atomic<bool>& flag;
+        } unlock{maintaining_};
+
+        size_t pending = pending_.load(std::memory_order_acquire);
+        if (pending || compact_dead) {
+            Compact(pending);
+        }
+        uint64_t epoch = epoch_.load();
+        if (!readers_[(epoch + 1) & 1].load()) {
+            epoch_.store(++epoch);
+        }
+        Reclaim(epoch);
+    }
+
+    void Compact(size_t pending) {
+        auto old = current_.load();
+        UniquePtr<Snapshot> fresh(new Snapshot);
+        fresh->entries.reserve(old->entries.size() + pending);
+        for (const auto& entry : old->entries) {
+            if (entry->active.load(std::memory_order_acquire) && !entry->observer.Expired()) {
+                fresh->entries.push_back(entry);
+            }
+        }
+        for (size_t i = 0; i < pending; ++i) {
+            auto node = Pop();
+            if (!node) {
+                break;
+            }
+            if (node->entry->active.load(std::memory_order_acquire)) {
+                fresh->entries.push_back(std::move(node->entry));
+            }
+            delete node;
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        current_.store(fresh.Release());
+        old->retired_epoch = epoch_.load();
+        old->next_retired = retired_;
+        retired_ = old;
+        retired_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Reclaim(uint64_t epoch) {
+        Snapshot** link = &retired_;
+        while (*link) {
+            auto snapshot = *link;
+            if (epoch >= snapshot->retired_epoch + 2) {
+                *link = snapshot->next_retired;
+                delete snapshot;
+                retired_count_.fetch_sub(1, std::memory_order_relaxed);
+            } else {
+                link = &snapshot->next_retired;
+            }
+        }
+    }
+
+    std::atomic<Snapshot*> current_;
+    std::atomic<uint64_t> epoch_ = 0;
+    mutable std::atomic<int64_t> readers_[2] = {0, 0};
+
+    std::atomic<bool> maintaining_ = false;
+    Snapshot* retired_ = nullptr;
+    std::atomic<size_t> retired_count_ = 0;
+
+    PendingNode stub_;
+    std::atomic<PendingNode*> tail_ = &stub_;
+    PendingNode* head_ = &stub_;
+    std::atomic<size_t> pending_ = 0;
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "shared.h"
+#include "unique.h"
+#include "weak.h"
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Trivial relocation
+
+// Moving an object to new storage and destroying the source is the same as copying its
+// bytes and forgetting the source. Specialize for types where that holds.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool kIsTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+template <typename T, typename CountPolicy>
+struct IsTriviallyRelocatable<BasicSharedPtr<T, CountPolicy>> : std::true_type {};
+
+template <typename T, typename CountPolicy>
+struct IsTriviallyRelocatable<BasicWeakPtr<T, CountPolicy>> : std::true_type {};
+
+template <typename T, typename Deleter>
+struct IsTriviallyRelocatable<UniquePtr<T, Deleter>> : IsTriviallyRelocatable<Deleter> {};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Vector relocating its elements with `memcpy` when allowed
+
+template <typename T>
+class RelocatingVector {
+public:
+    using Iterator = T*;
+    using ConstIterator = const T*;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Constructors
+
+    RelocatingVector() {
+    }
+
+    RelocatingVector(std::initializer_list<T> values) {
+        Reserve(values.size());
+        for (const auto& value : values) {
+            EmplaceBack(value);
+        }
+    }
+
+    RelocatingVector(const RelocatingVector& other) {
+        Reserve(other.size_);
+        for (const auto& value : other) {
+            EmplaceBack(value);
+        }
+    }
+
+    RelocatingVector(RelocatingVector&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // `operator=`-s
+
+    RelocatingVector& operator=(const RelocatingVector& other) {
+        RelocatingVector(other).Swap(*this);
+        return *this;
+    }
+
+    RelocatingVector& operator=(RelocatingVector&& other) noexcept {
+        RelocatingVector(std::move(other)).Swap(*this);
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Destructor
+
+    ~RelocatingVector() {
+        Clear();
+        Deallocate(data_, capacity_);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Modifiers
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == capacity_) {
+            size_t capacity = capacity_ ? 2 * capacity_ : 1;
+            T* data = Allocate(capacity);
+            T* element = nullptr;
+            // Construct first: `args` may refer to an element about to be relocated
+            try {
+                element = new (data + size_) T(std::forward<Args>(args)...);
+                Relocate(data, capacity);
+            } catch (...) {
+                if (element) {
+                    element->~T();
+                }
+                Deallocate(data, capacity);
+                throw;
+            }
+        } else {
+            new (data_ + size_) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() {
+        data_[--size_].~T();
+    }
+
+    // Removes the element at `pos` and shifts the tail down
+    Iterator Erase(ConstIterator pos) {
+        size_t index = pos - data_;
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            data_[index].~T();
+            std::memmove(static_cast<void*>(data_ + index), data_ + index + 1,
+                         (size_ - index - 1) * sizeof(T));
+        } else {
+            for (size_t i = index; i + 1 < size_; ++i) {
+                data_[i] = std::move(data_[i + 1]);
+            }
+            data_[size_ - 1].~T();
+        }
+        --size_;
+        return data_ + index;
+    }
+
+    void Reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            T* data = Allocate(capacity);
+            try {
+                Relocate(data, capacity);
+            } catch (...) {
+                Deallocate(data, capacity);
+                throw;
+            }
+        }
+    }
+
+    void Clear() {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void Swap(RelocatingVector& other) {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Observers
+
+    size_t Size() const {
+        return size_;
+    }
+
+    size_t Capacity() const {
+        return capacity_;
+    }
+
+    bool Empty() const {
+        return !size_;
+    }
+
+    T& operator[](size_t i) {
+        return data_[i];
+    }
+
+    const T& operator[](size_t i) const {
+        return data_[i];
+    }
+
+    T* Data() {
+        return data_;
+    }
+
+    Iterator begin() {
+        return data_;
+    }
+
+    Iterator end() {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const {
+        return data_;
+    }
+
+    ConstIterator end() const {
+        return data_ + size_;
+    }
+
+private:
+    static T* Allocate(size_t capacity) {
+        return std::allocator<T>().allocate(capacity);
+    }
+
+    static void Deallocate(T* data, size_t capacity) {
+        if (data) {
+            std::allocator<T>().deallocate(data, capacity);
+        }
+    }
+
+    // Moves the first `size_` elements into `data` and adopts it. Elements with a throwing
+    // move are copied instead, so if this throws they are left in place and `data` is
+    // still the caller's to free.
+    void Relocate(T* data, size_t capacity) {
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            if (size_) {
+                std::memcpy(static_cast<void*>(data), data_, size_ * sizeof(T));
+            }
+        } else {
+            if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                          !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(data_, data_ + size_, data);
+            } else {
+                std::uninitialized_copy(data_, data_ + size_, data);
+            }
+            std::destroy(data_, data_ + size_);
+        }
+        Deallocate(data_, capacity_);
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "shared.h"
+#include "weak.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Control block
+
+// Count split across cache-line-padded shards. Every handle remembers the shard it was
+// counted in, and while the primary handle is alive copies only ever touch that shard:
+// the primary's reference alone keeps `central` above zero, so nothing checks for zero.
+// Releasing the primary is the one reconciliation: every shard's count is moved into
+// `central` and the shard is marked folded, after which the remaining handles count there.
+// The block holds one ordinary reference to the object, which is how `WeakPtr`s and
+// plain `SharedPtr`s interoperate with it.
+template <typename T>
+struct ShardedControlBlock {
+    static constexpr size_t kShards = 64;
+    static constexpr size_t kCacheLine = 64;
+
+    // Stored in a shard once its count has moved to `central`; live counts stay far below
+    static constexpr int64_t kFolded = int64_t(1) << 62;
+
+    explicit ShardedControlBlock(SyncSharedPtr<T> anchor) : anchor(std::move(anchor)) {
+    }
+
+    // Shards are handed out to threads round-robin on first use
+    static size_t LocalShard() {
+        static std::atomic<size_t> next_shard = 0;
+        thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return shard;
+    }
+
+    static bool IsFolded(int64_t count) {
+        return count >= kFolded / 2;
+    }
+
+    void Increment(size_t shard) {
+        if (IsFolded(shards[shard].count.fetch_add(1, std::memory_order_relaxed))) {
+            central.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void Decrement(size_t shard) {
+        if (IsFolded(shards[shard].count.fetch_sub(1, std::memory_order_release))) {
+            // Reads within the release sequence of the fold's exchange, so its bias on
+            // `central` is seen first; only handles outliving the primary come here
+            shards[shard].count.load(std::memory_order_acquire);
+            DecrementCentral();
+        }
+    }
+
+    // Called once, when the primary handle is released. `central` carries an extra `kFolded`
+    // until every shard has been moved: a handle dropped on a shard that was just exchanged
+    // must not take it to zero before that shard's count arrives. `after_exchange` lets tests
+    // drop a handle in exactly that window.
+    template <typename AfterExchange>
+    void Fold(AfterExchange after_exchange) {
+        central.fetch_add(kFolded, std::memory_order_relaxed);
+        for (size_t i = 0; i < kShards; ++i) {
+            int64_t count = shards[i].count.exchange(kFolded, std::memory_order_acq_rel);
+            after_exchange(i);
+            central.fetch_add(count, std::memory_order_relaxed);
+        }
+        // The bias and the primary's own reference
+        if (central.fetch_sub(kFolded + 1, std::memory_order_acq_rel) == kFolded + 1) {
+            delete this;
+        }
+    }
+
+    void Fold() {
+        Fold([](size_t) {});
+    }
+
+    // Deletes the block on the last reference
+    void DecrementCentral() {
+        if (central.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    // Racy under concurrent copies
+    size_t UseCount() const {
+        int64_t count = central.load(std::memory_order_relaxed);
+        // A fold in progress holds `kFolded` on `central`
+        if (IsFolded(count)) {
+            count -= kFolded;
+        }
+        for (const auto& shard : shards) {
+            int64_t shard_count = shard.count.load(std::memory_order_relaxed);
+            if (!IsFolded(shard_count)) {
+                count += shard_count;
+            }
+        }
+        return count;
+    }
+
+    struct alignas(kCacheLine) Shard {
+        std::atomic<int64_t> count = 0;
+    };
+
+    Shard shards[kShards];
+    // The primary handle's reference until `Fold()`, every reference after it
+    alignas(kCacheLine) std::atomic<int64_t> central = 1;
+    SyncSharedPtr<T> anchor;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Handle
+
+// Opt-in handle for very hot, widely shared objects such as global configuration.
+// The handle made from a `SyncSharedPtr` is the primary (kept in the global slot, say);
+// while it lives, copies touch only the copying thread's shard. Once it is released the
+// remaining copies share one count, so the fast path lasts as long as the primary does.
+// The object itself stays owned by an ordinary `SyncSharedPtr`, so it lives until both
+// kinds of owner are gone.
+template <typename T>
+class ShardedSharedPtr {
+public:
+    using Block = ShardedControlBlock<T>;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Constructors
+
+    ShardedSharedPtr() {
+    }
+
+    ShardedSharedPtr(std::nullptr_t) {
+    }
+
+    // Starts a new sharded block owning one reference to `ptr`'s object
+    explicit ShardedSharedPtr(SyncSharedPtr<T> ptr) {
+        if (ptr) {
+            ptr_ = ptr.Get();
+            control_block_ = new Block(std::move(ptr));
+            primary_ = true;
+        }
+    }
+
+    ShardedSharedPtr(const ShardedSharedPtr& other)
+        : ptr_(other.ptr_), control_block_(other.control_block_), shard_(Block::LocalShard()) {
+        if (control_block_) {
+            control_block_->Increment(shard_);
+        }
+    }
+
+    ShardedSharedPtr(ShardedSharedPtr&& other) noexcept
+        : ptr_(std::exchange(other.ptr_, nullptr)),
+          control_block_(std::exchange(other.control_block_, nullptr)),
+          shard_(other.shard_),
+          primary_(std::exchange(other.primary_, false)) {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // `operator=`-s
+
+    ShardedSharedPtr& operator=(const ShardedSharedPtr& other) {
+        ShardedSharedPtr(other).Swap(*this);
+        return *this;
+    }
+
+    ShardedSharedPtr& operator=(ShardedSharedPtr&& other) noexcept {
+        ShardedSharedPtr(std::move(other)).Swap(*this);
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Destructor
+
+    ~ShardedSharedPtr() {
+        if (!control_block_) {
+            return;
+        }
+        if (primary_) {
+            control_block_->Fold();
+        } else {
+            control_block_->Decrement(shard_);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Modifiers
+
+    void Reset() {
+        ShardedSharedPtr().Swap(*this);
+    }
+
+    void Swap(ShardedSharedPtr& other) noexcept {
+        std::swap(ptr_, other.ptr_);
+        std::swap(control_block_, other.control_block_);
+        std::swap(shard_, other.shard_);
+        std::swap(primary_, other.primary_);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Conversions
+
+    SyncSharedPtr<T> ToShared() const {
+        if (!control_block_) {
+            return SyncSharedPtr<T>();
+        }
+        return control_block_->anchor;
+    }
+
+    SyncWeakPtr<T> ToWeak() const {
+        if (!control_block_) {
+            return SyncWeakPtr<T>();
+        }
+        return control_block_->anchor;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Observers
+
+    T* Get() const {
+        return ptr_;
+    }
+
+    T& operator*() const {
+        return *ptr_;
+    }
+
+    T* operator->() const {
+        return ptr_;
+    }
+
+    // Sharded owners only, `SyncSharedPtr` owners of the same object are not included
+    size_t UseCount() const {
+        if (!control_block_) {
+            return 0;
+        }
+        return control_block_->UseCount();
+    }
+
+    explicit operator bool() const {
+        return ptr_ != nullptr;
+    }
+
+    Block* GetControlBlock() const {
+        return control_block_;
+    }
+
+private:
+    T* ptr_ = nullptr;
+    Block* control_block_ = nullptr;
+    size_t shard_ = 0;
+    bool primary_ = false;
+};
+
+template <typename T, typename... Args>
+ShardedSharedPtr<T> MakeShardedShared(Args&&... args) {
+    return ShardedSharedPtr<T>(MakeSyncShared<T>(std::forward<Args>(args)...));
+}
@@ -5,122 +5,101 @@
 #include <cstddef>  // std::nullptr_t
 
 #include <iostream>
+#include <utility>
 
 struct EnableSharedFromThisBase {
     virtual ~EnableSharedFromThisBase() {
     }
 };
 
-template <typename T>
+template <typename T, typename CountPolicy>
 struct EnableSharedFromThis : EnableSharedFromThisBase {
-    SharedPtr<T> SharedFromThis() {
-        return self;
+    EnableSharedFromThis() {
+    }
+
+    // A copy is a different object: `self` is left alone and set by the copy's own owner
+    EnableSharedFromThis(const EnableSharedFromThis&) {
+    }
+
+    EnableSharedFromThis& operator=(const EnableSharedFromThis&) {
+        return *this;
     }
 
-    SharedPtr<const T> SharedFromThis() const {
+    BasicSharedPtr<T, CountPolicy> SharedFromThis() {
         return self;
     }
 
-    WeakPtr<T> WeakFromThis() noexcept {
+    BasicSharedPtr<const T, CountPolicy> SharedFromThis() const {
         return self;
     }
 
-    WeakPtr<const T> WeakFromThis() const noexcept {
+    BasicWeakPtr<T, CountPolicy> WeakFromThis() noexcept {
         return self;
     }
 
-    ~EnableSharedFromThis() override {
-        self.control_block_ = nullptr;
+    BasicWeakPtr<const T, CountPolicy> WeakFromThis() const noexcept {
+        return self;
     }
 
-    WeakPtr<T> self;
+    BasicWeakPtr<T, CountPolicy> self;
 };
 
 // https://en.cppreference.com/w/cpp/memory/shared_ptr
-template <typename T>
-class SharedPtr {
+template <typename T, typename CountPolicy>
+class BasicSharedPtr {
 public:
+    using Policy = CountPolicy;
+    using Block = BasicControlBlock<CountPolicy>;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Constructors
 
-    SharedPtr() {
-    }
-
-    SharedPtr(std::nullptr_t) {
-    }
-
-    explicit SharedPtr(T* ptr) : ptr_(ptr), control_block_(new PointerControlBlock<T>(ptr)) {
-        if constexpr (std::is_base_of_v<EnableSharedFromThisBase, T>) {
-            EnableSharedFromThisHelper(ptr);
-        }
-    }
-
-    template <typename U>
-    explicit SharedPtr(U* ptr) : ptr_(ptr), control_block_(new PointerControlBlock<U>(ptr)) {
-        if constexpr (std::is_base_of_v<EnableSharedFromThisBase, U>) {
-            EnableSharedFromThisHelper(ptr);
-        }
+    BasicSharedPtr() {
     }
 
-    SharedPtr(T* ptr, ControlBlock* control_block) : ptr_(ptr), control_block_(control_block) {
-        if constexpr (std::is_base_of_v<EnableSharedFromThisBase, T>) {
-            EnableSharedFromThisHelper(ptr);
-        }
+    BasicSharedPtr(std::nullptr_t) {
     }
 
     template <typename U>
-    SharedPtr(U* ptr, ControlBlock* control_block) : ptr_(ptr), control_block_(control_block) {
+    explicit BasicSharedPtr(U* ptr)
+        : ptr_(ptr), control_block_(new PointerControlBlock<U, CountPolicy>(ptr)) {
         if constexpr (std::is_base_of_v<EnableSharedFromThisBase, U>) {
             EnableSharedFromThisHelper(ptr);
         }
     }
 
-    template <typename Y>
-    void EnableSharedFromThisHelper(EnableSharedFromThis<Y>* base) {
-        base->self = *this;
-    }
-
-    SharedPtr(const SharedPtr& other) : ptr_(other.ptr_), control_block_(other.control_block_) {
+    BasicSharedPtr(const BasicSharedPtr& other)
+        : ptr_(other.ptr_), control_block_(other.control_block_) {
         if (control_block_) {
             control_block_->IncrementShared();
         }
     }
 
     template <typename U>
-    SharedPtr(const SharedPtr<U>& other)
+    BasicSharedPtr(const BasicSharedPtr<U, CountPolicy>& other)
         : ptr_(other.Get()), control_block_(other.GetControlBlock()) {
         if (control_block_) {
             control_block_->IncrementShared();
         }
     }
 
-    SharedPtr(SharedPtr&& other) : ptr_(other.ptr_), control_block_(other.control_block_) {
-        if (control_block_) {
-            control_block_->IncrementShared();
-        }
-        other.Reset();
+    BasicSharedPtr(BasicSharedPtr&& other) noexcept
+        : ptr_(other.ptr_), control_block_(other.control_block_) {
+        other.ptr_ = nullptr;
+        other.control_block_ = nullptr;
     }
 
     template <typename U>
-    SharedPtr(SharedPtr<U>&& other) : ptr_(other.Get()), control_block_(other.GetControlBlock()) {
-        if (control_block_) {
-            control_block_->IncrementShared();
-        }
-        other.Reset();
+    BasicSharedPtr(BasicSharedPtr<U, CountPolicy>&& other) noexcept
+        : ptr_(other.ptr_), control_block_(other.control_block_) {
+        other.ptr_ = nullptr;
+        other.control_block_ = nullptr;
     }
 
     // Aliasing constructor
     // #8 from https://en.cppreference.com/w/cpp/memory/shared_ptr/shared_ptr
     template <typename Y>
-    SharedPtr(const SharedPtr<Y>& other, T* ptr)
-        : ptr_(ptr), control_block_(other.GetControlBlock()) {
-        if (control_block_) {
-            control_block_->IncrementShared();
-        }
-    }
-
-    template <typename Y, typename U>
-    SharedPtr(const SharedPtr<Y>& other, U* ptr)
+    BasicSharedPtr(const BasicSharedPtr<Y, CountPolicy>& other, T* ptr)
         : ptr_(ptr), control_block_(other.GetControlBlock()) {
         if (control_block_) {
             control_block_->IncrementShared();
@@ -129,104 +108,43 @@ public:
 
     // Promote `WeakPtr`
     // #11 from https://en.cppreference.com/w/cpp/memory/shared_ptr/shared_ptr
-    SharedPtr(const WeakPtr<T>& other)
-        : ptr_(other.Get()), control_block_(other.GetControlBlock()) {
-        if (other.Expired()) {
-            throw BadWeakPtr();
-        }
-        if (control_block_) {
-            control_block_->IncrementShared();
-        }
-    }
-
     template <typename U>
-    SharedPtr(const WeakPtr<U>& other)
+    BasicSharedPtr(const BasicWeakPtr<U, CountPolicy>& other)
         : ptr_(other.Get()), control_block_(other.GetControlBlock()) {
-        if (other.Expired()) {
+        if (!control_block_ || !control_block_->IncrementSharedIfNotZero()) {
             throw BadWeakPtr();
         }
-        if (control_block_) {
-            control_block_->IncrementShared();
-        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // `operator=`-s
 
-    SharedPtr& operator=(const SharedPtr& other) {
-        if (control_block_ == other.control_block_) {
-            ptr_ = other.ptr_;
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementShared();
-        }
-        ptr_ = other.ptr_;
-        control_block_ = other.control_block_;
-        if (control_block_) {
-            control_block_->IncrementShared();
-        }
+    BasicSharedPtr& operator=(const BasicSharedPtr& other) {
+        BasicSharedPtr(other).Swap(*this);
         return *this;
     }
 
     template <typename U>
-    SharedPtr& operator=(const SharedPtr<U>& other) {
-        if (control_block_ == other.GetControlBlock()) {
-            ptr_ = other.Get();
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementShared();
-        }
-        ptr_ = other.Get();
-        control_block_ = other.GetControlBlock();
-        if (control_block_) {
-            control_block_->IncrementShared();
-        }
+    BasicSharedPtr& operator=(const BasicSharedPtr<U, CountPolicy>& other) {
+        BasicSharedPtr(other).Swap(*this);
         return *this;
     }
 
-    SharedPtr& operator=(SharedPtr&& other) {
-        if (control_block_ == other.control_block_) {
-            ptr_ = other.ptr_;
-            if (control_block_) {
-                control_block_->DecrementShared();
-            }
-            other.ptr_ = nullptr;
-            other.control_block_ = nullptr;
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementShared();
-        }
-        ptr_ = other.ptr_;
-        control_block_ = other.control_block_;
-        other.ptr_ = nullptr;
-        other.control_block_ = nullptr;
+    BasicSharedPtr& operator=(BasicSharedPtr&& other) noexcept {
+        BasicSharedPtr(std::move(other)).Swap(*this);
         return *this;
     }
 
     template <typename U>
-    SharedPtr& operator=(SharedPtr<U>&& other) {
-        if (control_block_ == other.GetControlBlock()) {
-            ptr_ = other.Get();
-            other.Reset();
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementShared();
-        }
-        ptr_ = other.Get();
-        control_block_ = other.GetControlBlock();
-        control_block_->IncrementShared();
-        other.Reset();
+    BasicSharedPtr& operator=(BasicSharedPtr<U, CountPolicy>&& other) noexcept {
+        BasicSharedPtr(std::move(other)).Swap(*this);
         return *this;
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Destructor
 
-    ~SharedPtr() {
+    ~BasicSharedPtr() {
         if (control_block_) {
             control_block_->DecrementShared();
         }
@@ -236,22 +154,7 @@ public:
     // Modifiers
 
     void Reset() {
-        if (control_block_) {
-            control_block_->DecrementShared();
-        }
-        ptr_ = nullptr;
-        control_block_ = nullptr;
-    }
-
-    void Reset(T* ptr) {
-        if (ptr_ == ptr) {
-            return;
-        }
-        if (control_block_) {
-            control_block_->DecrementShared();
-        }
-        ptr_ = ptr;
-        control_block_ = new PointerControlBlock<T>(ptr);
+        BasicSharedPtr().Swap(*this);
     }
 
     template <typename U>
@@ -259,21 +162,12 @@ public:
         if (ptr_ == ptr) {
             return;
         }
-        if (control_block_) {
-            control_block_->DecrementShared();
-        }
-        ptr_ = ptr;
-        control_block_ = new PointerControlBlock<U>(ptr);
+        BasicSharedPtr(ptr).Swap(*this);
     }
 
-    void Swap(SharedPtr& other) {
-        auto ptr = other.ptr_;
-        other.ptr_ = ptr_;
-        ptr_ = ptr;
-
-        auto cb = other.control_block_;
-        other.control_block_ = control_block_;
-        control_block_ = cb;
+    void Swap(BasicSharedPtr& other) noexcept {
+        std::swap(ptr_, other.ptr_);
+        std::swap(control_block_, other.control_block_);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -295,35 +189,89 @@ public:
         if (!control_block_) {
             return 0;
         }
-        return control_block_->shared_count_;
+        return control_block_->SharedCount();
+    }
+
+    // Safe to mutate the object after this returns true, as long as no `WeakPtr` can
+    // be promoted concurrently: writes made through released owners are visible
+    bool IsUnique() const {
+        return control_block_ && control_block_->IsSharedUnique();
     }
 
     explicit operator bool() const {
         return ptr_ != nullptr;
     }
 
-    ControlBlock* GetControlBlock() const {
+    Block* GetControlBlock() const {
         return control_block_;
     }
 
 private:
+    // Adopts one shared reference already held on `control_block`; only the factories and
+    // handle types below, which have taken that reference themselves, may call it
+    template <typename U>
+    BasicSharedPtr(U* ptr, Block* control_block) : ptr_(ptr), control_block_(control_block) {
+        if constexpr (std::is_base_of_v<EnableSharedFromThisBase, U>) {
+            EnableSharedFromThisHelper(ptr);
+        }
+    }
+
+    template <typename Y>
+    void EnableSharedFromThisHelper(EnableSharedFromThis<Y, CountPolicy>* base) {
+        if (base->self.Expired()) {
+            base->self = *this;
+        }
+    }
+
+    // Gives up ownership without touching the count
+    Block* Detach() {
+        auto control_block = control_block_;
+        ptr_ = nullptr;
+        control_block_ = nullptr;
+        return control_block;
+    }
+
     T* ptr_ = nullptr;
-    ControlBlock* control_block_ = nullptr;
+    Block* control_block_ = nullptr;
+
+    template <typename U, typename P>
+    friend class BasicSharedPtr;
+
+    template <typename U, typename P>
+    friend class BasicWeakPtr;
 
-    friend struct EnableSharedFromThisBase;
+    template <typename P>
+    friend class batch_detail::SharedCountBatch;
+
+    template <typename P>
+    friend class BasicSharedBuffer;
 
     template <typename U>
-    friend struct EnableSharedFromThis;
+    friend class HandleTable;
+
+    template <typename U, typename P, typename... Args>
+    friend BasicSharedPtr<U, P> MakeBasicShared(Args&&... args);
 };
 
-template <typename T, typename U>
-inline bool operator==(const SharedPtr<T>& left, const SharedPtr<U>& right) {
+template <typename T, typename U, typename CountPolicy>
+inline bool operator==(const BasicSharedPtr<T, CountPolicy>& left,
+                       const BasicSharedPtr<U, CountPolicy>& right) {
     return left.Get() == right.Get();
 }
 
 // Allocate memory only once
+template <typename T, typename CountPolicy, typename... Args>
+BasicSharedPtr<T, CountPolicy> MakeBasicShared(Args&&... args) {
+    auto block = new EmplaceControlBlock<T, CountPolicy>(std::forward<Args>(args)...);
+    return BasicSharedPtr<T, CountPolicy>(block->GetRawPtr(), block);
+}
+
 template <typename T, typename... Args>
 SharedPtr<T> MakeShared(Args&&... args) {
-    auto block = new EmplaceControlBlock<T>(std::forward<Args>(args)...);
-    return SharedPtr<T>(block->GetRawPtr(), block);
+    return MakeBasicShared<T, SingleThreadedCount>(std::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+SyncSharedPtr<T> MakeSyncShared(Args&&... args) {
+    return MakeBasicShared<T, AtomicCount>(std::forward<Args>(args)...);
 }
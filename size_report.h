@@ -0,0 +1,50 @@
+#pragma once
+
+#include "shared.h"
+#include "unique.h"
+#include "weak.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+// Bytes a general-purpose allocator hands out for a request of `size`: an 8-byte chunk
+// header and 16-byte granularity with a 32-byte minimum, as in glibc malloc on 64-bit.
+constexpr size_t AllocatorRoundedSize(size_t size) {
+    return std::max<size_t>(32, (size + sizeof(size_t) + 15) / 16 * 16);
+}
+
+// Layout of every handle and control block for `T` under `CountPolicy`.
+// `SharedPtr`/`WeakPtr` never carry a deleter, so their size depends on neither.
+template <typename T, typename CountPolicy = SingleThreadedCount>
+struct SizeReport {
+    static constexpr size_t kSharedPtr = sizeof(BasicSharedPtr<T, CountPolicy>);
+    static constexpr size_t kWeakPtr = sizeof(BasicWeakPtr<T, CountPolicy>);
+    static constexpr size_t kUniquePtr = sizeof(UniquePtr<T>);
+
+    template <typename Deleter>
+    static constexpr size_t kUniquePtrWith = sizeof(UniquePtr<T, Deleter>);
+
+    static constexpr size_t kBaseBlock = sizeof(BasicControlBlock<CountPolicy>);
+    static constexpr size_t kPointerBlock = sizeof(PointerControlBlock<T, CountPolicy>);
+    static constexpr size_t kEmplaceBlock = sizeof(EmplaceControlBlock<T, CountPolicy>);
+
+    // Alignment and tail padding around the inline object
+    static constexpr size_t kEmplacePadding = kEmplaceBlock - kBaseBlock - sizeof(T);
+
+    // Heap bytes behind `SharedPtr<T>(new T)` and `MakeShared<T>()`
+    static constexpr size_t kPointerAllocated =
+        AllocatorRoundedSize(kPointerBlock) + AllocatorRoundedSize(sizeof(T));
+    static constexpr size_t kEmplaceAllocated = AllocatorRoundedSize(kEmplaceBlock);
+
+    static void Print(std::ostream& out, const char* name) {
+        out << name << ":\n"
+            << "  SharedPtr            " << kSharedPtr << "\n"
+            << "  WeakPtr              " << kWeakPtr << "\n"
+            << "  UniquePtr            " << kUniquePtr << "\n"
+            << "  PointerControlBlock  " << kPointerBlock << " (" << kPointerAllocated
+            << " allocated with the object)\n"
+            << "  EmplaceControlBlock  " << kEmplaceBlock << " (" << kEmplacePadding
+            << " padding, " << kEmplaceAllocated << " allocated)\n";
+    }
+};
@@ -1,86 +1,233 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <exception>
+#include <new>
 #include <type_traits>
 #include <iostream>
 
 class BadWeakPtr : public std::exception {};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Counting policies
+
+// Plain integers, for handles that never cross threads
+struct SingleThreadedCount {
+    using Counter = int;
+
+    static constexpr bool kThreadSafe = false;
+
+    static void Increment(Counter& counter, int n = 1) {
+        counter += n;
+    }
+
+    // Returns the new value
+    static int Decrement(Counter& counter, int n = 1) {
+        return counter -= n;
+    }
+
+    static bool IncrementIfNotZero(Counter& counter) {
+        if (!counter) {
+            return false;
+        }
+        ++counter;
+        return true;
+    }
+
+    static int Load(const Counter& counter) {
+        return counter;
+    }
+
+    static int LoadAcquire(const Counter& counter) {
+        return counter;
+    }
+};
+
+// Atomic counters, for handles shared between threads
+struct AtomicCount {
+    using Counter = std::atomic<int>;
+
+    static constexpr bool kThreadSafe = true;
+
+    static void Increment(Counter& counter, int n = 1) {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // Returns the new value
+    static int Decrement(Counter& counter, int n = 1) {
+        return counter.fetch_sub(n, std::memory_order_acq_rel) - n;
+    }
+
+    static bool IncrementIfNotZero(Counter& counter) {
+        int value = counter.load(std::memory_order_relaxed);
+        while (value) {
+            if (counter.compare_exchange_weak(value, value + 1, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static int Load(const Counter& counter) {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    // Synchronizes with the release half of `Decrement` in the other owners
+    static int LoadAcquire(const Counter& counter) {
+        return counter.load(std::memory_order_acquire);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Forward declarations
+
+template <typename T, typename CountPolicy = SingleThreadedCount>
+class BasicSharedPtr;
+
+template <typename T, typename CountPolicy = SingleThreadedCount>
+class BasicWeakPtr;
+
 template <typename T>
-class SharedPtr;
+using SharedPtr = BasicSharedPtr<T>;
 
 template <typename T>
-class WeakPtr;
+using WeakPtr = BasicWeakPtr<T>;
+
+template <typename T>
+using SyncSharedPtr = BasicSharedPtr<T, AtomicCount>;
+
+template <typename T>
+using SyncWeakPtr = BasicWeakPtr<T, AtomicCount>;
 
 struct EnableSharedFromThisBase;
 
+template <typename CountPolicy = SingleThreadedCount>
+class BasicSharedBuffer;
+
 template <typename T>
+class HandleTable;
+
+template <typename T, typename CountPolicy = SingleThreadedCount>
 struct EnableSharedFromThis;
 
-struct ControlBlock {
-    void IncrementShared() {
-        shared_count_++;
+namespace batch_detail {
+
+template <typename CountPolicy>
+class SharedCountBatch;
+
+}  // namespace batch_detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Accounting
+
+// Bytes held by live control block allocations, objects stored inline included.
+// Only tracked when built with SMART_POINTERS_TRACK_CONTROL_BLOCKS, which changes the
+// control block class: set it for the whole build (the CMake option of the same name),
+// never in individual files.
+struct ControlBlockTally {
+    static void Add([[maybe_unused]] size_t bytes) {
+#ifdef SMART_POINTERS_TRACK_CONTROL_BLOCKS
+        live_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        live_blocks_.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    static void Remove([[maybe_unused]] size_t bytes) {
+#ifdef SMART_POINTERS_TRACK_CONTROL_BLOCKS
+        live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        live_blocks_.fetch_sub(1, std::memory_order_relaxed);
+#endif
+    }
+
+    static size_t LiveBytes() {
+        return live_bytes_.load(std::memory_order_relaxed);
+    }
+
+    static size_t LiveBlocks() {
+        return live_blocks_.load(std::memory_order_relaxed);
+    }
+
+    inline static std::atomic<size_t> live_bytes_ = 0;
+    inline static std::atomic<size_t> live_blocks_ = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Control blocks
+
+// Shared owners collectively hold one weak reference, so the block stays alive while
+// the object is being destroyed, even if the object drops weak references to itself
+template <typename CountPolicy>
+struct BasicControlBlock {
+    void IncrementShared(int n = 1) {
+        CountPolicy::Increment(shared_count_, n);
     }
 
-    virtual void DecrementShared() {
-        shared_count_--;
-        if (!shared_count_) {
+    bool IncrementSharedIfNotZero() {
+        return CountPolicy::IncrementIfNotZero(shared_count_);
+    }
+
+    void DecrementShared(int n = 1) {
+        if (!CountPolicy::Decrement(shared_count_, n)) {
             OnZeroShared();
-        }
-        if (!weak_count_ && !shared_count_) {
-            OnZeroWeak();
+            DecrementWeak();
         }
     }
 
     void IncrementWeak() {
-        weak_count_++;
+        CountPolicy::Increment(weak_count_);
     }
 
-    virtual void DecrementWeak() {
-        weak_count_--;
-        if (!weak_count_ && !shared_count_) {
+    void DecrementWeak() {
+        if (!CountPolicy::Decrement(weak_count_)) {
             OnZeroWeak();
         }
     }
 
-    virtual ~ControlBlock() = default;
+    int SharedCount() const {
+        return CountPolicy::Load(shared_count_);
+    }
 
-    virtual void OnZeroShared() = 0;
-    virtual void OnZeroWeak() = 0;
+    bool IsSharedUnique() const {
+        return CountPolicy::LoadAcquire(shared_count_) == 1;
+    }
 
-    int shared_count_ = 1;
-    int weak_count_ = 0;
-};
+    virtual ~BasicControlBlock() = default;
 
-template <typename T>
-struct PointerControlBlock : ControlBlock {
-    void DecrementShared() override {
-        shared_count_--;
-        if (!shared_count_) {
-            OnZeroShared();
-        }
-        if (!weak_count_ && !shared_count_) {
-            OnZeroWeak();
-        }
-        if constexpr (std::is_base_of_v<EnableSharedFromThisBase, T>) {
-            if (weak_count_ == 1 && !shared_count_) {
-                OnZeroWeak();
-            }
-        }
+#ifdef SMART_POINTERS_TRACK_CONTROL_BLOCKS
+    static void* operator new(size_t size) {
+        ControlBlockTally::Add(size);
+        return ::operator new(size);
     }
 
-    void DecrementWeak() override {
-        weak_count_--;
-        if (!weak_count_ && !shared_count_) {
-            OnZeroWeak();
-        }
-        if constexpr (std::is_base_of_v<EnableSharedFromThisBase, T>) {
-            if (weak_count_ == 1 && !shared_count_) {
-                OnZeroWeak();
-            }
-        }
+    static void* operator new(size_t size, std::align_val_t alignment) {
+        ControlBlockTally::Add(size);
+        return ::operator new(size, alignment);
     }
 
+    static void operator delete(void* ptr, size_t size) {
+        ControlBlockTally::Remove(size);
+        ::operator delete(ptr);
+    }
+
+    static void operator delete(void* ptr, size_t size, std::align_val_t alignment) {
+        ControlBlockTally::Remove(size);
+        ::operator delete(ptr, alignment);
+    }
+#endif
+
+    virtual void OnZeroShared() = 0;
+    virtual void OnZeroWeak() = 0;
+
+    typename CountPolicy::Counter shared_count_{1};
+    typename CountPolicy::Counter weak_count_{1};
+};
+
+using ControlBlock = BasicControlBlock<SingleThreadedCount>;
+
+// Object allocated separately from the block
+template <typename T, typename CountPolicy = SingleThreadedCount>
+struct PointerControlBlock : BasicControlBlock<CountPolicy> {
     explicit PointerControlBlock(T* ptr) : ptr_(ptr) {
     }
 
@@ -94,41 +241,12 @@ struct PointerControlBlock : ControlBlock {
         delete this;
     }
 
-    ~PointerControlBlock() override {
-    }
-
     T* ptr_ = nullptr;
 };
 
-template <typename T>
-struct EmplaceControlBlock : public ControlBlock {
-    void DecrementShared() override {
-        shared_count_--;
-        if (!shared_count_) {
-            OnZeroShared();
-        }
-        if (!weak_count_ && !shared_count_) {
-            OnZeroWeak();
-        }
-        if constexpr (std::is_base_of_v<EnableSharedFromThisBase, T>) {
-            if (weak_count_ == 1 && !shared_count_) {
-                OnZeroWeak();
-            }
-        }
-    }
-
-    void DecrementWeak() override {
-        weak_count_--;
-        if (!weak_count_ && !shared_count_) {
-            OnZeroWeak();
-        }
-        if constexpr (std::is_base_of_v<EnableSharedFromThisBase, T>) {
-            if (weak_count_ == 1 && !shared_count_) {
-                OnZeroWeak();
-            }
-        }
-    }
-
+// Object stored inside the block
+template <typename T, typename CountPolicy = SingleThreadedCount>
+struct EmplaceControlBlock : BasicControlBlock<CountPolicy> {
     template <typename... Args>
     EmplaceControlBlock(Args&&... args) {
         new (&storage) T(std::forward<Args>(args)...);
@@ -147,4 +265,4 @@ struct EmplaceControlBlock : public ControlBlock {
     }
 
     std::aligned_storage_t<sizeof(T), alignof(T)> storage;
-};
\ No newline at end of file
+};
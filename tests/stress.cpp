@@ -0,0 +1,61 @@
+#include "stress.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Usage: stress [--threads N] [--operations N] [--slots N] [--mailboxes N] [--seed N]
+// Counts must be positive. Exits with 1 if any invariant was violated, 2 on bad arguments.
+
+namespace {
+
+// Whole decimal number in `text`; false if there is anything else
+bool ParseNumber(const char* text, long long& value) {
+    char* end = nullptr;
+    value = std::strtoll(text, &end, 10);
+    return end != text && !*end;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    StressConfig config;
+    for (int i = 1; i < argc; i += 2) {
+        long long value = 0;
+        if (i + 1 == argc || !ParseNumber(argv[i + 1], value)) {
+            std::fprintf(stderr, "%s needs a number\n", argv[i]);
+            return 2;
+        }
+        if (!std::strcmp(argv[i], "--seed")) {
+            config.seed = value;
+            continue;
+        }
+        if (value <= 0) {
+            std::fprintf(stderr, "%s must be positive\n", argv[i]);
+            return 2;
+        }
+        if (!std::strcmp(argv[i], "--threads")) {
+            config.threads = value;
+        } else if (!std::strcmp(argv[i], "--operations")) {
+            config.operations_per_thread = value;
+        } else if (!std::strcmp(argv[i], "--slots")) {
+            config.slots_per_thread = value;
+        } else if (!std::strcmp(argv[i], "--mailboxes")) {
+            config.mailboxes = value;
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    auto report = RunOwnershipStress(config);
+    std::printf("threads %zu, operations %zu, %.3f s, %.0f ops/s\n", config.threads,
+                report.operations, report.seconds, report.OperationsPerSecond());
+    std::printf("constructed %zu, destroyed %zu, failures %zu\n", report.constructed,
+                report.destroyed, report.failures);
+    if (!report.Ok()) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "shared.h"
+#include "weak.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Randomized ownership stress for `SharedPtr`/`WeakPtr`: every thread copies, moves, resets,
+// locks and drops its own handles and hands copies to other threads through mailboxes, so
+// counts are raised on one thread and dropped on another. Objects check that they are
+// only touched while alive and destroyed exactly once.
+//
+// Meant to be run from a binary built with -fsanitize=thread or -fsanitize=address, such as
+// the stress_tsan and stress_asan targets built from stress.cpp; the report carries
+// throughput so a slowdown shows up in the same run.
+
+struct StressConfig {
+    size_t threads = 4;
+    size_t operations_per_thread = 100000;
+    size_t slots_per_thread = 16;
+    size_t mailboxes = 8;
+    uint64_t seed = 1;
+};
+
+struct StressReport {
+    size_t operations = 0;
+    double seconds = 0;
+    size_t constructed = 0;
+    size_t destroyed = 0;
+    size_t failures = 0;
+
+    double OperationsPerSecond() const {
+        return seconds > 0 ? operations / seconds : 0;
+    }
+
+    // Nothing touched after death and every object destroyed exactly once
+    bool Ok() const {
+        return !failures && constructed == destroyed;
+    }
+};
+
+template <typename CountPolicy = AtomicCount>
+class OwnershipStress {
+    // The thread count is only known at run time, so non-atomic counts are rejected outright
+    static_assert(CountPolicy::kThreadSafe,
+                  "OwnershipStress shares handles between threads, the counts must be atomic");
+
+public:
+    explicit OwnershipStress(const StressConfig& config) : config_(config) {
+        if (!config.slots_per_thread || !config.mailboxes) {
+            throw std::invalid_argument("OwnershipStress needs at least one slot and mailbox");
+        }
+    }
+
+    StressReport Run() {
+        std::vector<std::atomic<BasicSharedPtr<Object, CountPolicy>*>> mailboxes(config_.mailboxes);
+        for (auto& mailbox : mailboxes) {
+            mailbox.store(nullptr);
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < config_.threads; ++i) {
+            threads.emplace_back([this, i, &mailboxes] { Worker(i, mailboxes); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto& mailbox : mailboxes) {
+            delete mailbox.exchange(nullptr);
+        }
+        auto finish = std::chrono::steady_clock::now();
+
+        StressReport report;
+        report.operations = config_.threads * config_.operations_per_thread;
+        report.seconds = std::chrono::duration<double>(finish - start).count();
+        report.constructed = counters_.constructed.load();
+        report.destroyed = counters_.destroyed.load();
+        report.failures = counters_.failures.load();
+        return report;
+    }
+
+private:
+    struct Counters {
+        std::atomic<size_t> constructed = 0;
+        std::atomic<size_t> destroyed = 0;
+        std::atomic<size_t> failures = 0;
+    };
+
+    struct Object : EnableSharedFromThis<Object, CountPolicy> {
+        static constexpr uint64_t kAlive = 0xA11CEA11CEA11CEull;
+        static constexpr uint64_t kDead = 0xDEADDEADDEADDEADull;
+
+        explicit Object(Counters& counters) : counters(counters) {
+            counters.constructed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ~Object() override {
+            if (state.exchange(kDead) != kAlive) {
+                counters.failures.fetch_add(1, std::memory_order_relaxed);
+            }
+            counters.destroyed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void Check() const {
+            if (state.load() != kAlive) {
+                counters.failures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        Counters& counters;
+        std::atomic<uint64_t> state = kAlive;
+    };
+
+    using Shared = BasicSharedPtr<Object, CountPolicy>;
+    using Weak = BasicWeakPtr<Object, CountPolicy>;
+
+    void Fail() {
+        counters_.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void CheckHeld(const Shared& ptr) {
+        if (!ptr) {
+            return;
+        }
+        ptr->Check();
+        if (ptr.UseCount() < 1) {
+            Fail();
+        }
+    }
+
+    void Worker(size_t index, std::vector<std::atomic<Shared*>>& mailboxes) {
+        std::mt19937_64 random(config_.seed + index);
+        std::vector<Shared> shared(config_.slots_per_thread);
+        std::vector<Weak> weak(config_.slots_per_thread);
+        auto slot = [&] { return random() % config_.slots_per_thread; };
+
+        for (size_t i = 0; i < config_.operations_per_thread; ++i) {
+            auto& target = shared[slot()];
+            switch (random() % 12) {
+                case 0:
+                    target = MakeBasicShared<Object, CountPolicy>(counters_);
+                    break;
+                case 1:
+                    target = Shared(new Object(counters_));
+                    break;
+                case 2:
+                    target = shared[slot()];
+                    break;
+                case 3:
+                    target = std::move(shared[slot()]);
+                    break;
+                case 4:
+                    target.Reset();
+                    break;
+                case 5:
+                    weak[slot()] = target;
+                    break;
+                case 6: {
+                    auto& from = weak[slot()];
+                    auto locked = from.Lock();
+                    if (locked) {
+                        CheckHeld(locked);
+                        target = std::move(locked);
+                    }
+                    break;
+                }
+                case 7:
+                    weak[slot()].Reset();
+                    break;
+                case 8:
+                    if (target) {
+                        auto self = target->SharedFromThis();
+                        if (self.Get() != target.Get()) {
+                            Fail();
+                        }
+                        weak[slot()] = target->WeakFromThis();
+                    }
+                    break;
+                case 9:
+                    if (target) {
+                        delete mailboxes[random() % mailboxes.size()].exchange(new Shared(target));
+                    }
+                    break;
+                case 10:
+                    if (auto received = mailboxes[random() % mailboxes.size()].exchange(nullptr)) {
+                        CheckHeld(*received);
+                        target = std::move(*received);
+                        delete received;
+                    }
+                    break;
+                default:
+                    target.Swap(shared[slot()]);
+                    break;
+            }
+            CheckHeld(target);
+        }
+    }
+
+    StressConfig config_;
+    Counters counters_;
+};
+
+template <typename CountPolicy = AtomicCount>
+StressReport RunOwnershipStress(const StressConfig& config = StressConfig()) {
+    return OwnershipStress<CountPolicy>(config).Run();
+}
@@ -0,0 +1,74 @@
+#include "arena.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+int alive = 0;
+
+struct Node {
+    Node() {
+        ++alive;
+    }
+
+    ~Node() {
+        --alive;
+    }
+
+    Node* next = nullptr;
+    std::string name;
+};
+
+struct alignas(64) Wide {
+    char bytes[100];
+};
+
+}  // namespace
+
+TEST_CASE("Arena nodes share one control block", "[arena]") {
+    SharedPtr<Node> root;
+    {
+        SharedArena arena(256);
+        root = arena.Make<Node>();
+        Node* last = root.Get();
+        for (int i = 0; i < 10000; ++i) {
+            auto node = arena.Create<Node>();
+            node->name = "a name long enough to leave the small string buffer";
+            last->next = node;
+            last = node;
+        }
+        auto number = arena.Make<int>(5);
+        REQUIRE(*number == 5);
+        REQUIRE(root.GetControlBlock() == number.GetControlBlock());
+        REQUIRE(root.UseCount() == 3);
+    }
+    REQUIRE(alive == 10001);
+    REQUIRE(root.UseCount() == 1);
+    REQUIRE(root->next->next->name.size() > 16);
+
+    root.Reset();
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Arena allocations are aligned", "[arena]") {
+    ArenaRegion region(128);
+    for (int i = 0; i < 100; ++i) {
+        region.Allocate(1 + i % 7, 1);
+        auto wide = region.Create<Wide>();
+        REQUIRE(reinterpret_cast<uintptr_t>(wide) % alignof(Wide) == 0);
+    }
+    auto large = region.Allocate(1 << 20, 16);
+    REQUIRE(reinterpret_cast<uintptr_t>(large) % 16 == 0);
+    REQUIRE(region.BytesReserved() >= (1 << 20));
+}
+
+TEST_CASE("Sync arena", "[arena]") {
+    SyncSharedArena arena;
+    auto value = arena.Make<long>(3);
+    SyncSharedPtr<long> copy = value;
+    REQUIRE(*copy == 3);
+    REQUIRE(value.UseCount() == 3);
+}
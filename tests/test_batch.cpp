@@ -0,0 +1,103 @@
+#include "batch.h"
+
+#include <catch2/catch.hpp>
+
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+int alive = 0;
+
+struct Foo {
+    Foo() {
+        ++alive;
+    }
+
+    ~Foo() {
+        --alive;
+    }
+};
+
+}  // namespace
+
+static_assert(std::is_nothrow_move_constructible_v<SharedPtrVector<Foo>>);
+static_assert(std::is_nothrow_move_assignable_v<SharedPtrVector<Foo>>);
+
+TEST_CASE("CopyShared and ReleaseAll", "[batch]") {
+    {
+        auto a = MakeShared<Foo>();
+        auto b = MakeShared<Foo>();
+        std::vector<SharedPtr<Foo>> ptrs;
+        for (int i = 0; i < 100; ++i) {
+            ptrs.push_back(i % 3 ? a : b);
+        }
+        for (int i = 0; i < 20; ++i) {
+            ptrs.push_back(MakeShared<Foo>());
+        }
+
+        auto copies = CopyShared(ptrs);
+        REQUIRE(copies.size() == ptrs.size());
+        REQUIRE(a.UseCount() == 1 + 2 * 66);
+        REQUIRE(b.UseCount() == 1 + 2 * 34);
+
+        ReleaseAll(copies);
+        REQUIRE(copies.empty());
+        REQUIRE(a.UseCount() == 67);
+
+        ReleaseAll(ptrs.begin(), ptrs.end());
+        REQUIRE(a.UseCount() == 1);
+        REQUIRE(alive == 2);
+    }
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Released copy outlives slot overflow", "[batch]") {
+    {
+        auto ptr = MakeShared<Foo>();
+        std::vector<SharedPtr<int>> others;
+        for (size_t i = 0; i <= batch_detail::SharedCountBatch<SingleThreadedCount>::kSlots; ++i) {
+            others.push_back(MakeShared<int>());
+        }
+
+        batch_detail::SharedCountBatch<SingleThreadedCount> batch;
+        auto copy = batch.Share(ptr);
+        batch.Release(ptr);
+        for (auto& other : others) {
+            batch.Release(other);
+        }
+        REQUIRE(alive == 1);
+        REQUIRE(copy.UseCount() == 1);
+
+        batch.Release(copy);
+        batch.Flush();
+        REQUIRE(alive == 0);
+    }
+    REQUIRE(alive == 0);
+}
+
+TEMPLATE_TEST_CASE("SharedPtrVector", "[batch]", SingleThreadedCount, AtomicCount) {
+    using Vector = BasicSharedPtrVector<Foo, TestType>;
+    {
+        auto a = MakeBasicShared<Foo, TestType>();
+        auto b = MakeBasicShared<Foo, TestType>();
+
+        Vector first(1000, a);
+        REQUIRE(a.UseCount() == 1001);
+        Vector second = first;
+        REQUIRE(a.UseCount() == 2001);
+
+        first = Vector{a, b};
+        REQUIRE(a.UseCount() == 1002);
+        second.Assign(2, second[0]);
+        REQUIRE(a.UseCount() == 4);
+
+        // Growth moves the inner vectors instead of copying every handle
+        std::vector<Vector> outer;
+        for (int i = 0; i < 100; ++i) {
+            outer.emplace_back(10, b);
+        }
+        REQUIRE(b.UseCount() == 1 + 1 + 100 * 10);
+    }
+    REQUIRE(alive == 0);
+}
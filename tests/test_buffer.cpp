@@ -0,0 +1,86 @@
+#include "buffer.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace {
+
+bool fail_move = false;
+
+// Throws on the move into the control block while `fail_move` is set, which fails building
+// the block the same way a failed allocation would
+struct FragileDeleter {
+    explicit FragileDeleter(int& released) : released(&released) {
+    }
+
+    FragileDeleter(FragileDeleter&& other) : released(other.released) {
+        if (fail_move) {
+            fail_move = false;
+            throw std::bad_alloc();
+        }
+    }
+
+    void operator()(std::byte* data, size_t) const {
+        delete[] data;
+        ++*released;
+    }
+
+    int* released;
+};
+
+}  // namespace
+
+TEST_CASE("Slices share the buffer", "[buffer]") {
+    SharedSlice tail;
+    {
+        auto buffer = SharedBuffer::Allocate(11);
+        std::memcpy(buffer.Data(), "hello world", 11);
+        auto world = buffer.Slice(6);
+        tail = world.Slice(1, 3);
+        REQUIRE(world.AsStringView() == "world");
+        REQUIRE(tail.AsStringView() == "orl");
+        REQUIRE(tail.Data() == buffer.Data() + 7);
+        REQUIRE(buffer.Slice(11).Empty());
+        REQUIRE_THROWS_AS(world.Slice(3, 10), std::out_of_range);
+        REQUIRE_THROWS_AS(world.Slice(6), std::out_of_range);
+    }
+    REQUIRE(tail.AsStringView() == "orl");
+    REQUIRE(tail.GetOwner().UseCount() == 1);
+}
+
+TEST_CASE("Adopted bytes are released by the deleter", "[buffer]") {
+    int released = 0;
+    auto deleter = [&released](std::byte* data, size_t) {
+        delete[] data;
+        ++released;
+    };
+    {
+        auto buffer = SyncSharedBuffer::Adopt(new std::byte[4], 4, deleter);
+        auto slice = buffer.Slice(1);
+        buffer = SyncSharedBuffer();
+        REQUIRE(released == 0);
+    }
+    REQUIRE(released == 1);
+
+    fail_move = true;
+    REQUIRE_THROWS_AS(SharedBuffer::Adopt(new std::byte[4], 4, FragileDeleter(released)),
+                      std::bad_alloc);
+    REQUIRE(released == 2);
+}
+
+TEST_CASE("Mapped files", "[buffer]") {
+    char path[] = "/tmp/test_buffer_XXXXXX";
+    int fd = ::mkstemp(path);
+    REQUIRE(fd >= 0);
+    std::string contents = "mapped file contents";
+    REQUIRE(::write(fd, contents.data(), contents.size()) == ssize_t(contents.size()));
+    ::close(fd);
+
+    auto slice = SharedBuffer::MapFile(path).Slice(7, 4);
+    ::unlink(path);
+    REQUIRE(slice.AsStringView() == "file");
+    REQUIRE_THROWS_AS(SharedBuffer::MapFile("/nonexistent/file"), std::system_error);
+}
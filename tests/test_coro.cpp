@@ -0,0 +1,177 @@
+#include "coro.h"
+
+#include <catch2/catch.hpp>
+
+#include <coroutine>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+int alive = 0;
+int finished = 0;
+
+// Parks the coroutine until the test resumes `parked`
+std::coroutine_handle<> parked;
+
+struct Park {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        parked = handle;
+    }
+
+    void await_resume() const noexcept {
+    }
+};
+
+void ResumeParked() {
+    std::exchange(parked, nullptr).resume();
+}
+
+struct Service : EnableSharedFromThis<Service> {
+    Service() {
+        ++alive;
+    }
+
+    ~Service() {
+        --alive;
+    }
+
+    PinnedTask Run(bool fail) {
+        co_await Park{};
+        ++finished;
+        if (fail) {
+            throw std::runtime_error("Run");
+        }
+    }
+
+    PinnedTask Finish(bool fail) {
+        ++finished;
+        if (fail) {
+            throw std::runtime_error("Finish");
+        }
+        co_return;
+    }
+
+    // The service owns the task that pins it
+    PinnedTask task;
+};
+
+PinnedTask Await(PinnedTask& task, bool& caught) {
+    try {
+        co_await task;
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    ++finished;
+}
+
+PinnedTask Nested(int depth) {
+    if (depth) {
+        auto inner = Nested(depth - 1);
+        co_await inner;
+    }
+    ++finished;
+}
+
+}  // namespace
+
+TEST_CASE("Pin keeps the object alive until completion", "[coro]") {
+    finished = 0;
+    auto owner = MakeShared<Service>();
+    auto task = owner->Run(false);
+    REQUIRE(task.Pinned());
+    owner.Reset();
+    task.Resume();
+    REQUIRE(alive == 1);
+    ResumeParked();
+    REQUIRE(task.Done());
+    REQUIRE_FALSE(task.Pinned());
+    REQUIRE(finished == 1);
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Unowned objects are not pinned", "[coro]") {
+    finished = 0;
+    {
+        Service service;
+        auto task = service.Finish(false);
+        REQUIRE_FALSE(task.Pinned());
+        task.Resume();
+        REQUIRE(task.Done());
+        REQUIRE(finished == 1);
+    }
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Awaiter outlives the frame the pin drop frees", "[coro]") {
+    for (bool fail : {false, true}) {
+        finished = 0;
+        bool caught = false;
+        auto owner = MakeShared<Service>();
+        owner->task = owner->Run(fail);
+        auto waiter = Await(owner->task, caught);
+        waiter.Resume();
+        owner.Reset();
+        REQUIRE(alive == 1);
+
+        // Finishing drops the last owner, which destroys the service and the awaited frame
+        ResumeParked();
+        REQUIRE(alive == 0);
+        REQUIRE(waiter.Done());
+        REQUIRE(finished == 2);
+        REQUIRE(caught == fail);
+    }
+}
+
+TEST_CASE("Resume survives the task being destroyed", "[coro]") {
+    for (bool fail : {false, true}) {
+        finished = 0;
+        auto owner = MakeShared<Service>();
+        owner->task = owner->Finish(fail);
+        Service* service = owner.Get();
+        owner.Reset();
+
+        // The task is a member of the service its completion destroys
+        if (fail) {
+            REQUIRE_THROWS_AS(service->task.Resume(), std::runtime_error);
+        } else {
+            service->task.Resume();
+        }
+        REQUIRE(finished == 1);
+        REQUIRE(alive == 0);
+    }
+}
+
+TEST_CASE("Awaiting a default-constructed task", "[coro]") {
+    finished = 0;
+    bool caught = false;
+    PinnedTask empty;
+    REQUIRE(empty.Done());
+    auto waiter = Await(empty, caught);
+    waiter.Resume();
+    REQUIRE(waiter.Done());
+    REQUIRE(finished == 1);
+    REQUIRE_FALSE(caught);
+}
+
+TEST_CASE("Awaiting finished and nested tasks", "[coro]") {
+    finished = 0;
+    bool caught = false;
+    auto owner = MakeShared<Service>();
+    auto failed = owner->Finish(true);
+    REQUIRE_THROWS_AS(failed.Resume(), std::runtime_error);
+    REQUIRE_THROWS_AS(failed.Resume(), std::runtime_error);
+    auto waiter = Await(failed, caught);
+    waiter.Resume();
+    REQUIRE(caught);
+
+    finished = 0;
+    auto nested = Nested(100);
+    nested.Resume();
+    REQUIRE(nested.Done());
+    REQUIRE(finished == 101);
+}
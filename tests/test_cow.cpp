@@ -0,0 +1,53 @@
+#include "cow.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Copies share until written", "[cow]") {
+    Cow<std::map<std::string, int>> a;
+    a.Write()["x"] = 1;
+    auto b = a;
+    REQUIRE(b.UseCount() == 2);
+    REQUIRE(&b.Read() == &a.Read());
+
+    b.Write()["y"] = 2;
+    REQUIRE(a->size() == 1);
+    REQUIRE(b->size() == 2);
+    REQUIRE_FALSE(a.IsShared());
+
+    auto& first = a.Write();
+    auto& second = a.Write();
+    REQUIRE(&first == &second);
+
+    Cow<int> moved = 5;
+    Cow<int> target = std::move(moved);
+    REQUIRE(*target == 5);
+}
+
+TEST_CASE("SyncCow writes from many threads", "[cow]") {
+    SyncCow<std::vector<int>> shared(std::vector<int>(100, 1));
+    std::atomic<int> failures = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([shared, &failures]() mutable {
+            for (int j = 0; j < 1000; ++j) {
+                auto copy = shared;
+                copy.Write()[0] = j;
+                if (copy.UseCount() != 1) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(failures == 0);
+    REQUIRE((*shared)[0] == 1);
+    REQUIRE(shared.UseCount() == 1);
+}
@@ -0,0 +1,90 @@
+#include "handle_table.h"
+#include "weak.h"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+namespace {
+
+int alive = 0;
+
+struct Entity {
+    explicit Entity(int id) : id(id) {
+        ++alive;
+    }
+
+    ~Entity() {
+        --alive;
+    }
+
+    int id;
+};
+
+}  // namespace
+
+TEST_CASE("Handles resolve until erased", "[handle_table]") {
+    {
+        HandleTable<Entity> table;
+        auto first = table.Insert(1);
+        REQUIRE(first);
+        REQUIRE(first.Index() == 0);
+        REQUIRE(table.Resolve(first)->id == 1);
+
+        REQUIRE(table.Erase(first));
+        REQUIRE_FALSE(table.Erase(first));
+        REQUIRE_FALSE(table.Resolve(first));
+        REQUIRE(alive == 0);
+
+        // The slot is reused under a new generation
+        auto second = table.Insert(2);
+        REQUIRE(second.Index() == first.Index());
+        REQUIRE_FALSE(second == first);
+        REQUIRE_FALSE(table.Contains(first));
+        REQUIRE(table.Resolve(second)->id == 2);
+        REQUIRE_FALSE(table.Resolve(GenerationalHandle()));
+    }
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Locked objects outlive the erase", "[handle_table]") {
+    HandleTable<Entity> table;
+    auto handle = table.Insert(3);
+    auto locked = table.Lock(handle);
+    WeakPtr<Entity> weak = locked;
+    REQUIRE(table.Erase(handle));
+    REQUIRE(alive == 1);
+    REQUIRE(table.Lock(handle)->id == 3);
+
+    locked.Reset();
+    REQUIRE(alive == 0);
+    REQUIRE(weak.Expired());
+    REQUIRE_FALSE(table.Lock(handle));
+
+    // The weak reference keeps the slot out of the free list
+    auto other = table.Insert(4);
+    REQUIRE(other.Index() != handle.Index());
+    weak.Reset();
+    auto reused = table.Insert(5);
+    REQUIRE(reused.Index() == handle.Index());
+}
+
+TEST_CASE("Growth keeps objects in place", "[handle_table]") {
+    HandleTable<Entity> table;
+    std::vector<GenerationalHandle> handles;
+    std::vector<Entity*> objects;
+    for (int i = 0; i < 3 * static_cast<int>(HandleTable<Entity>::kChunkSize); ++i) {
+        handles.push_back(table.Insert(i));
+        objects.push_back(table.Resolve(handles.back()));
+    }
+    REQUIRE(table.Capacity() == 3 * HandleTable<Entity>::kChunkSize);
+    for (size_t i = 0; i < handles.size(); ++i) {
+        REQUIRE(table.Resolve(handles[i]) == objects[i]);
+        REQUIRE(objects[i]->id == static_cast<int>(i));
+    }
+    for (size_t i = 0; i < handles.size(); i += 2) {
+        table.Erase(handles[i]);
+    }
+    REQUIRE(table.Size() == handles.size() / 2);
+    REQUIRE(alive == static_cast<int>(handles.size() / 2));
+}
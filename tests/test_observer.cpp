@@ -0,0 +1,122 @@
+#include "observer.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> alive = 0;
+
+struct Subscriber {
+    Subscriber() {
+        ++alive;
+    }
+
+    ~Subscriber() {
+        --alive;
+    }
+
+    std::atomic<int> events = 0;
+};
+
+size_t PublishNothing(ObserverList<Subscriber>& list) {
+    return list.Publish([](Subscriber&) {});
+}
+
+}  // namespace
+
+TEST_CASE("Subscribe, unsubscribe and expire", "[observer]") {
+    {
+        ObserverList<Subscriber> list;
+        std::vector<SyncSharedPtr<Subscriber>> owners;
+        for (int i = 0; i < 100; ++i) {
+            owners.push_back(MakeSyncShared<Subscriber>());
+            list.Subscribe(owners.back());
+        }
+        // Subscriptions become visible at the next compaction
+        REQUIRE(PublishNothing(list) == 0);
+        REQUIRE(list.Publish([](Subscriber& subscriber) { ++subscriber.events; }) == 100);
+        REQUIRE(owners[0]->events == 1);
+
+        auto subscription = list.Subscribe(owners[0]);
+        PublishNothing(list);
+        REQUIRE(subscription.Active());
+        REQUIRE(PublishNothing(list) == 101);
+
+        subscription.Unsubscribe();
+        REQUIRE_FALSE(subscription.Active());
+        REQUIRE(PublishNothing(list) == 100);
+
+        owners.resize(50);
+        REQUIRE(PublishNothing(list) == 50);
+        PublishNothing(list);
+        REQUIRE(list.SnapshotSize() <= 51);
+    }
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Unsubscribe before the subscription is visible", "[observer]") {
+    ObserverList<Subscriber> list;
+    auto owner = MakeSyncShared<Subscriber>();
+    auto subscription = list.Subscribe(owner);
+    subscription.Unsubscribe();
+    PublishNothing(list);
+    REQUIRE(PublishNothing(list) == 0);
+    REQUIRE(list.SnapshotSize() == 0);
+}
+
+TEST_CASE("Publish during churn", "[observer]") {
+    {
+        ObserverList<Subscriber> list;
+        std::vector<SyncSharedPtr<Subscriber>> owners;
+        for (int i = 0; i < 1000; ++i) {
+            owners.push_back(MakeSyncShared<Subscriber>());
+            list.Subscribe(owners.back());
+        }
+        PublishNothing(list);
+
+        std::atomic<bool> stop = false;
+        std::atomic<int> short_deliveries = 0;
+        std::vector<std::thread> publishers;
+        for (int i = 0; i < 3; ++i) {
+            publishers.emplace_back([&] {
+                while (!stop.load()) {
+                    auto delivered = list.Publish([](Subscriber& subscriber) {
+                        subscriber.events.fetch_add(1, std::memory_order_relaxed);
+                    });
+                    // The long-lived subscribers are never missed
+                    if (delivered < owners.size()) {
+                        ++short_deliveries;
+                    }
+                }
+            });
+        }
+        std::vector<std::thread> churners;
+        for (int i = 0; i < 3; ++i) {
+            churners.emplace_back([&list, i] {
+                for (int j = 0; j < 5000; ++j) {
+                    auto subscriber = MakeSyncShared<Subscriber>();
+                    auto subscription = list.Subscribe(subscriber);
+                    if ((i + j) % 2) {
+                        subscription.Unsubscribe();
+                    }
+                }
+            });
+        }
+        for (auto& thread : churners) {
+            thread.join();
+        }
+        stop = true;
+        for (auto& thread : publishers) {
+            thread.join();
+        }
+        REQUIRE(short_deliveries == 0);
+
+        PublishNothing(list);
+        REQUIRE(PublishNothing(list) == owners.size());
+    }
+    REQUIRE(alive == 0);
+}
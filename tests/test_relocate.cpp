@@ -0,0 +1,137 @@
+#include "relocate.h"
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+int alive = 0;
+
+struct Foo {
+    explicit Foo(int value) : value(value) {
+        ++alive;
+    }
+
+    ~Foo() {
+        --alive;
+    }
+
+    int value;
+};
+
+// Copies and moves throw once `constructions_left` runs out
+int constructions_left = -1;
+
+struct Fragile {
+    explicit Fragile(int value) : value(value) {
+        ++alive;
+    }
+
+    Fragile(const Fragile& other) : value(other.value) {
+        Construct();
+    }
+
+    Fragile(Fragile&& other) : value(other.value) {
+        Construct();
+    }
+
+    ~Fragile() {
+        --alive;
+    }
+
+    void Construct() {
+        if (!constructions_left) {
+            throw std::runtime_error("Fragile");
+        }
+        --constructions_left;
+        ++alive;
+    }
+
+    int value;
+};
+
+}  // namespace
+
+static_assert(kIsTriviallyRelocatable<SharedPtr<Foo>>);
+static_assert(kIsTriviallyRelocatable<WeakPtr<Foo>>);
+static_assert(kIsTriviallyRelocatable<UniquePtr<Foo>>);
+static_assert(kIsTriviallyRelocatable<UniquePtr<Foo[]>>);
+static_assert(!kIsTriviallyRelocatable<std::string>);
+static_assert(!kIsTriviallyRelocatable<Fragile>);
+
+TEST_CASE("Relocating handles keeps counts", "[relocate]") {
+    {
+        RelocatingVector<SharedPtr<Foo>> ptrs;
+        auto shared = MakeShared<Foo>(1);
+        for (int i = 0; i < 1000; ++i) {
+            ptrs.PushBack(i % 2 ? shared : MakeShared<Foo>(i));
+        }
+        REQUIRE(shared.UseCount() == 501);
+
+        ptrs.EmplaceBack(ptrs[1]);
+        REQUIRE(shared.UseCount() == 502);
+        ptrs.Erase(ptrs.begin() + 1);
+        REQUIRE(shared.UseCount() == 501);
+        REQUIRE(ptrs.Size() == 1000);
+
+        auto copy = ptrs;
+        REQUIRE(shared.UseCount() == 1001);
+
+        RelocatingVector<UniquePtr<Foo>> unique;
+        for (int i = 0; i < 100; ++i) {
+            unique.EmplaceBack(new Foo(i));
+        }
+        unique.Erase(unique.begin());
+        REQUIRE(unique[0]->value == 1);
+        REQUIRE(unique.Size() == 99);
+    }
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Types that are not trivially relocatable", "[relocate]") {
+    RelocatingVector<std::string> strings{"a", "b", "c"};
+    for (int i = 0; i < 100; ++i) {
+        strings.PushBack(std::string(50, 'x'));
+    }
+    strings.Erase(strings.begin());
+    REQUIRE(strings[0] == "b");
+
+    strings.PushBack(strings[0]);
+    REQUIRE(strings[strings.Size() - 1] == "b");
+
+    RelocatingVector<std::string> moved = std::move(strings);
+    REQUIRE(strings.Empty());
+    strings = moved;
+    REQUIRE(strings.Size() == moved.Size());
+}
+
+TEST_CASE("Throwing relocation leaves the vector intact", "[relocate]") {
+    {
+        RelocatingVector<Fragile> values;
+        values.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            values.EmplaceBack(i);
+        }
+
+        // The new element is built, then the second relocated copy throws
+        constructions_left = 2;
+        REQUIRE_THROWS_AS(values.PushBack(Fragile(9)), std::runtime_error);
+        REQUIRE(alive == 4);
+
+        constructions_left = 1;
+        REQUIRE_THROWS_AS(values.Reserve(16), std::runtime_error);
+        REQUIRE(alive == 4);
+
+        constructions_left = -1;
+        REQUIRE(values.Size() == 4);
+        REQUIRE(values.Capacity() == 4);
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(values[i].value == i);
+        }
+        values.EmplaceBack(4);
+        REQUIRE(values[4].value == 4);
+    }
+    REQUIRE(alive == 0);
+}
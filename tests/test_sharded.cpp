@@ -0,0 +1,148 @@
+#include "sharded.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> alive = 0;
+
+struct Config {
+    explicit Config(int value) : value(value) {
+        ++alive;
+    }
+
+    ~Config() {
+        --alive;
+    }
+
+    int value;
+};
+
+}  // namespace
+
+TEST_CASE("Copies on many threads keep one object alive", "[sharded]") {
+    {
+        auto primary = MakeShardedShared<Config>(7);
+        std::atomic<int> failures = 0;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 10000; ++i) {
+                    auto copy = primary;
+                    if (copy->value != 7) {
+                        ++failures;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(failures == 0);
+        REQUIRE(primary.UseCount() == 1);
+        REQUIRE(alive == 1);
+    }
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Copies outlive the primary", "[sharded]") {
+    std::vector<ShardedSharedPtr<Config>> copies;
+    {
+        auto primary = MakeShardedShared<Config>(1);
+        for (int i = 0; i < 100; ++i) {
+            copies.push_back(primary);
+        }
+        REQUIRE(primary.UseCount() == 101);
+    }
+    REQUIRE(alive == 1);
+    REQUIRE(copies.front().UseCount() == 100);
+
+    // Copies made after the fold count centrally
+    auto late = copies.front();
+    REQUIRE(late.UseCount() == 101);
+    copies.clear();
+    REQUIRE(alive == 1);
+    late.Reset();
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Handles released on other threads", "[sharded]") {
+    auto primary = MakeShardedShared<Config>(2);
+    std::vector<ShardedSharedPtr<Config>> copies;
+    std::thread([&] {
+        for (int i = 0; i < 1000; ++i) {
+            copies.push_back(primary);
+        }
+    }).join();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = t; i < copies.size(); i += 4) {
+                copies[i].Reset();
+            }
+        });
+    }
+    // Folding while the copies drain
+    primary.Reset();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Handle dropped while its shard is being folded", "[sharded]") {
+    using Block = ShardedControlBlock<Config>;
+    // The block's own count stands for the primary; one copy is counted on this thread's shard
+    auto block = new Block(MakeSyncShared<Config>(5));
+    size_t shard = Block::LocalShard();
+    block->Increment(shard);
+
+    // The copy goes away after its shard is exchanged but before that count reaches `central`
+    block->Fold([&](size_t folded) {
+        if (folded == shard) {
+            block->Decrement(shard);
+            REQUIRE(alive == 1);
+            REQUIRE(block->UseCount() == 0);
+        }
+    });
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Moves keep the primary", "[sharded]") {
+    auto primary = MakeShardedShared<Config>(3);
+    auto copy = primary;
+    auto moved = std::move(primary);
+    REQUIRE_FALSE(primary);
+    copy.Reset();
+    REQUIRE(moved.UseCount() == 1);
+
+    ShardedSharedPtr<Config> other;
+    other = std::move(moved);
+    other.Swap(moved);
+    moved = moved;
+    REQUIRE(alive == 1);
+    moved.Reset();
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Weak and shared interop", "[sharded]") {
+    SyncWeakPtr<Config> weak;
+    SyncSharedPtr<Config> shared;
+    {
+        auto primary = MakeShardedShared<Config>(4);
+        weak = primary.ToWeak();
+        shared = primary.ToShared();
+        REQUIRE(shared.Get() == primary.Get());
+        REQUIRE_FALSE(weak.Expired());
+    }
+    REQUIRE_FALSE(weak.Expired());
+    REQUIRE(shared->value == 4);
+    shared.Reset();
+    REQUIRE(weak.Expired());
+    REQUIRE(alive == 0);
+}
@@ -0,0 +1,136 @@
+#include "shared.h"
+#include "weak.h"
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+int alive = 0;
+
+struct Base {
+    Base() {
+        ++alive;
+    }
+
+    virtual ~Base() {
+        --alive;
+    }
+
+    int value = 1;
+};
+
+struct Derived : Base {};
+
+template <typename CountPolicy>
+struct Self : EnableSharedFromThis<Self<CountPolicy>, CountPolicy> {
+    Self() {
+        ++alive;
+    }
+
+    Self(const Self& other) : EnableSharedFromThis<Self, CountPolicy>(other) {
+        ++alive;
+    }
+
+    Self& operator=(const Self&) = default;
+
+    ~Self() override {
+        --alive;
+    }
+};
+
+}  // namespace
+
+TEMPLATE_TEST_CASE("Shared and weak counts", "[shared]", SingleThreadedCount, AtomicCount) {
+    using Shared = BasicSharedPtr<Base, TestType>;
+    using Weak = BasicWeakPtr<Base, TestType>;
+    {
+        auto a = MakeBasicShared<Base, TestType>();
+        Shared b = a;
+        REQUIRE(a.UseCount() == 2);
+
+        Weak weak = a;
+        a.Reset();
+        REQUIRE_FALSE(weak.Expired());
+        b = nullptr;
+        REQUIRE(weak.Expired());
+        REQUIRE_FALSE(weak.Lock());
+        REQUIRE_THROWS_AS(Shared(weak), BadWeakPtr);
+
+        Shared c(new Derived);
+        BasicSharedPtr<Derived, TestType> d(new Derived);
+        c = d;
+        c = std::move(d);
+        REQUIRE(c.UseCount() == 1);
+
+        BasicSharedPtr<int, TestType> alias(c, &c->value);
+        c.Reset();
+        REQUIRE(*alias == 1);
+    }
+    REQUIRE(alive == 0);
+}
+
+TEMPLATE_TEST_CASE("SharedFromThis", "[shared]", SingleThreadedCount, AtomicCount) {
+    using Object = Self<TestType>;
+    {
+        auto a = MakeBasicShared<Object, TestType>();
+        auto self = a->SharedFromThis();
+        REQUIRE(self == a);
+        REQUIRE(a.UseCount() == 2);
+
+        BasicWeakPtr<Object, TestType> weak = a->WeakFromThis();
+        a.Reset();
+        self.Reset();
+        REQUIRE(weak.Expired());
+    }
+    REQUIRE(alive == 0);
+}
+
+TEMPLATE_TEST_CASE("SharedFromThis of a copy returns the copy", "[shared]", SingleThreadedCount,
+                   AtomicCount) {
+    using Object = Self<TestType>;
+    {
+        auto a = MakeBasicShared<Object, TestType>();
+        auto b = MakeBasicShared<Object, TestType>(*a);
+        REQUIRE(b->SharedFromThis() == b);
+        REQUIRE(a->SharedFromThis() == a);
+
+        auto c = MakeBasicShared<Object, TestType>();
+        *c = *a;
+        REQUIRE(c->SharedFromThis() == c);
+        REQUIRE(a.UseCount() == 1);
+
+        Object unowned(*a);
+        REQUIRE(unowned.WeakFromThis().Expired());
+    }
+    REQUIRE(alive == 0);
+}
+
+// Adopting a reference without counting it is reserved for the library's own factories
+static_assert(!std::is_constructible_v<SharedPtr<int>, int*, ControlBlock*>);
+static_assert(!std::is_constructible_v<SyncSharedPtr<Base>, Derived*, SyncSharedPtr<Base>::Block*>);
+
+TEST_CASE("Atomic counts across threads", "[shared]") {
+    {
+        auto shared = MakeSyncShared<Self<AtomicCount>>();
+        SyncWeakPtr<Self<AtomicCount>> weak = shared;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&] {
+                for (int j = 0; j < 10000; ++j) {
+                    auto copy = shared;
+                    auto locked = weak.Lock();
+                    auto self = copy->SharedFromThis();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(shared.UseCount() == 1);
+    }
+    REQUIRE(alive == 0);
+}
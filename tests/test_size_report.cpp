@@ -0,0 +1,83 @@
+#include "size_report.h"
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+struct Payload {
+    double values[5] = {};
+};
+
+struct alignas(32) Overaligned {
+    char bytes[40];
+};
+
+struct EmptyDeleter {
+    void operator()(int* ptr) const noexcept {
+        delete ptr;
+    }
+};
+
+constexpr size_t kPtr = sizeof(void*);
+constexpr size_t kCounts = 2 * sizeof(int);
+
+}  // namespace
+
+// Layouts on 64-bit targets; a change that grows any of them fails this build
+
+static_assert(SizeReport<int>::kSharedPtr == 2 * kPtr);
+static_assert(SizeReport<int>::kWeakPtr == 2 * kPtr);
+static_assert(SizeReport<int, AtomicCount>::kSharedPtr == 2 * kPtr);
+static_assert(SizeReport<int>::kUniquePtr == kPtr);
+static_assert(SizeReport<int>::kUniquePtrWith<EmptyDeleter> == kPtr);
+static_assert(sizeof(UniquePtr<int[]>) == kPtr);
+
+static_assert(SizeReport<int>::kBaseBlock == kPtr + kCounts);
+static_assert(SizeReport<int, AtomicCount>::kBaseBlock == kPtr + kCounts);
+static_assert(SizeReport<int>::kPointerBlock == kPtr + kCounts + kPtr);
+static_assert(SizeReport<Overaligned>::kPointerBlock == kPtr + kCounts + kPtr);
+
+static_assert(SizeReport<int>::kEmplacePadding < alignof(ControlBlock));
+static_assert(SizeReport<double>::kEmplacePadding == 0);
+static_assert(SizeReport<Overaligned>::kEmplaceBlock == 32 + 64);
+
+TEST_CASE("Tally follows control block lifetimes", "[size_report]") {
+    size_t bytes = ControlBlockTally::LiveBytes();
+    size_t blocks = ControlBlockTally::LiveBlocks();
+    {
+        SharedPtr<Payload> separate(new Payload);
+        REQUIRE(ControlBlockTally::LiveBlocks() == blocks + 1);
+        REQUIRE(ControlBlockTally::LiveBytes() == bytes + SizeReport<Payload>::kPointerBlock);
+
+        WeakPtr<Payload> weak;
+        {
+            auto inline_ptr = MakeShared<Payload>();
+            weak = inline_ptr;
+            auto copy = inline_ptr;
+            REQUIRE(ControlBlockTally::LiveBlocks() == blocks + 2);
+            REQUIRE(ControlBlockTally::LiveBytes() == bytes + SizeReport<Payload>::kPointerBlock +
+                                                          SizeReport<Payload>::kEmplaceBlock);
+        }
+        // The weak reference keeps the emplace block, object storage included
+        REQUIRE(ControlBlockTally::LiveBlocks() == blocks + 2);
+        weak.Reset();
+        REQUIRE(ControlBlockTally::LiveBlocks() == blocks + 1);
+    }
+    REQUIRE(ControlBlockTally::LiveBytes() == bytes);
+    REQUIRE(ControlBlockTally::LiveBlocks() == blocks);
+}
+
+TEST_CASE("Report matches sizeof", "[size_report]") {
+    REQUIRE(SizeReport<Payload>::kEmplaceBlock == SizeReport<Payload>::kBaseBlock +
+                                                       sizeof(Payload) +
+                                                       SizeReport<Payload>::kEmplacePadding);
+    REQUIRE(SizeReport<Payload>::kEmplaceAllocated % 16 == 0);
+
+    std::ostringstream out;
+    SizeReport<Payload>::Print(out, "Payload");
+    auto line = "SharedPtr            " + std::to_string(SizeReport<Payload>::kSharedPtr);
+    REQUIRE(out.str().find(line) != std::string::npos);
+}
@@ -0,0 +1,124 @@
+#include "unique.h"
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int deletions = 0;
+
+struct CountingDelete {
+    void operator()(int* ptr) const noexcept {
+        ++deletions;
+        delete ptr;
+    }
+
+    int id = 0;
+};
+
+struct Base {
+    virtual ~Base() = default;
+};
+
+struct Derived : Base {};
+
+// Copyable member next to a `UniquePtr`: growth moves it only if the move is noexcept
+struct Holder {
+    UniquePtr<int> ptr;
+    std::string name;
+};
+
+}  // namespace
+
+static_assert(std::is_nothrow_move_constructible_v<UniquePtr<int, CountingDelete>>);
+static_assert(std::is_nothrow_move_assignable_v<UniquePtr<int, CountingDelete>>);
+static_assert(std::is_nothrow_move_constructible_v<Holder>);
+static_assert(std::is_nothrow_invocable_v<DefaultDelete<int>, int*>);
+static_assert(std::is_nothrow_invocable_v<const DefaultDelete<int[]>&, int*>);
+static_assert(!std::is_copy_constructible_v<UniquePtr<int>>);
+static_assert(sizeof(UniquePtr<int>) == sizeof(int*));
+static_assert(sizeof(UniquePtr<int, CountingDelete>) == 2 * sizeof(int*));
+
+// Guarantees containers rely on
+static_assert(std::is_nothrow_move_constructible_v<UniquePtr<int>>);
+static_assert(std::is_nothrow_move_assignable_v<UniquePtr<int>>);
+static_assert(std::is_nothrow_move_constructible_v<UniquePtr<int[]>>);
+static_assert(std::is_nothrow_move_assignable_v<UniquePtr<int[]>>);
+static_assert(std::is_nothrow_destructible_v<UniquePtr<int>>);
+static_assert(noexcept(std::declval<UniquePtr<int>&>().Swap(std::declval<UniquePtr<int>&>())));
+
+constexpr int ConstantEvaluatedSingle() {
+    UniquePtr<int> single(new int(2));
+    UniquePtr<int> other;
+    other.Swap(single);
+    UniquePtr<int> moved = std::move(other);
+    moved.Reset(new int(*moved + 1));
+    return *moved + (single ? 1 : 0) + (other ? 1 : 0);
+}
+
+constexpr int ConstantEvaluatedArray() {
+    UniquePtr<int[]> array(new int[3]{1, 2, 3});
+    array[0] = 10;
+    UniquePtr<int[]> moved = std::move(array);
+    UniquePtr<int[]> other(new int[2]{4, 5});
+    other.Swap(moved);
+    moved.Reset(new int[1]{7});
+    int* raw = other.Release();
+    int sum = raw[0] + raw[2] + moved[0] + (array ? 100 : 0) + (other ? 100 : 0);
+    delete[] raw;
+    moved = nullptr;
+    return sum + (moved ? 100 : 0);
+}
+
+static_assert(ConstantEvaluatedSingle() == 3);
+static_assert(ConstantEvaluatedArray() == 20);
+
+TEST_CASE("Swap exchanges deleters", "[unique]") {
+    UniquePtr<int, CountingDelete> a(new int(1), CountingDelete{1});
+    UniquePtr<int, CountingDelete> b(new int(2), CountingDelete{2});
+    a.Swap(b);
+    REQUIRE(*a == 2);
+    REQUIRE(a.GetDeleter().id == 2);
+    REQUIRE(b.GetDeleter().id == 1);
+}
+
+TEST_CASE("Deleter runs once per owned object", "[unique]") {
+    deletions = 0;
+    {
+        UniquePtr<int, CountingDelete> empty(nullptr, CountingDelete{});
+        UniquePtr<int, CountingDelete> owner(new int(1), CountingDelete{});
+        auto moved = std::move(owner);
+        owner = std::move(moved);
+        owner.Reset(new int(2));
+        REQUIRE(deletions == 1);
+        empty.Reset();
+    }
+    REQUIRE(deletions == 2);
+}
+
+TEST_CASE("Vector growth keeps the pointers", "[unique]") {
+    std::vector<Holder> holders;
+    std::vector<int*> raw;
+    for (int i = 0; i < 1000; ++i) {
+        holders.push_back({UniquePtr<int>(new int(i)), std::to_string(i)});
+        raw.push_back(holders.back().ptr.Get());
+    }
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(holders[i].ptr.Get() == raw[i]);
+        REQUIRE(*holders[i].ptr == i);
+    }
+}
+
+TEST_CASE("Converting moves", "[unique]") {
+    UniquePtr<Base> base = UniquePtr<Derived>(new Derived);
+    REQUIRE(dynamic_cast<Derived*>(base.Get()));
+
+    UniquePtr<int[]> array(new int[3]{1, 2, 3});
+    UniquePtr<int[]> other = std::move(array);
+    REQUIRE_FALSE(array);
+    REQUIRE(other[2] == 3);
+}
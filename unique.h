@@ -9,14 +9,14 @@
 
 template <typename T>
 struct DefaultDelete {
-    void operator()(T* ptr) {
+    constexpr void operator()(T* ptr) const noexcept {
         delete ptr;
     }
 };
 
 template <typename T>
 struct DefaultDelete<T[]> {
-    void operator()(T* ptr) const noexcept {
+    constexpr void operator()(T* ptr) const noexcept {
         delete[] ptr;
     }
 };
@@ -28,26 +28,27 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Constructors
 
-    explicit UniquePtr(T* ptr = nullptr) noexcept : ptr_(ptr) {
+    constexpr explicit UniquePtr(T* ptr = nullptr) noexcept : ptr_(ptr) {
     }
 
     template <typename D>
-    UniquePtr(T* ptr, D&& deleter) noexcept : ptr_(ptr), deleter_(std::forward<D>(deleter)) {
+    constexpr UniquePtr(T* ptr, D&& deleter) noexcept
+        : ptr_(ptr), deleter_(std::forward<D>(deleter)) {
     }
 
     template <typename U>
-    UniquePtr(UniquePtr<U, DefaultDelete<U>>&& other) noexcept : ptr_(other.Release()) {
+    constexpr UniquePtr(UniquePtr<U, DefaultDelete<U>>&& other) noexcept : ptr_(other.Release()) {
     }
 
     template <typename U, typename D>
-    UniquePtr(UniquePtr<U, D>&& other) noexcept
+    constexpr UniquePtr(UniquePtr<U, D>&& other) noexcept
         : ptr_(other.Release()), deleter_(std::forward<D>(other.GetDeleter())) {
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // `operator=`-s
 
-    UniquePtr& operator=(UniquePtr&& other) noexcept {
+    constexpr UniquePtr& operator=(UniquePtr&& other) noexcept {
         if (this == &other) {
             return *this;
         }
@@ -56,7 +57,7 @@ public:
         return *this;
     }
 
-    UniquePtr& operator=(std::nullptr_t) {
+    constexpr UniquePtr& operator=(std::nullptr_t) noexcept {
         Reset();
         return *this;
     }
@@ -64,58 +65,62 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Destructor
 
-    ~UniquePtr() {
-        deleter_(ptr_);
+    constexpr ~UniquePtr() {
+        if (ptr_) {
+            deleter_(ptr_);
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Modifiers
 
-    T* Release() {
+    constexpr T* Release() noexcept {
         T* ptr = ptr_;
         ptr_ = nullptr;
         return ptr;
     }
 
-    void Reset(T* ptr = nullptr) noexcept {
+    constexpr void Reset(T* ptr = nullptr) noexcept {
         T* old_ptr = ptr_;
         ptr_ = ptr;
-        deleter_(old_ptr);
+        if (old_ptr) {
+            deleter_(old_ptr);
+        }
     }
 
-    void Swap(UniquePtr& other) {
-        T* ptr = ptr_;
-        ptr_ = other.ptr_;
-        other.ptr_ = ptr;
+    constexpr void Swap(UniquePtr& other) noexcept(std::is_nothrow_swappable_v<Deleter>) {
+        using std::swap;
+        swap(ptr_, other.ptr_);
+        swap(deleter_, other.deleter_);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Observers
 
-    T* Get() const {
+    constexpr T* Get() const noexcept {
         return ptr_;
     }
 
-    Deleter& GetDeleter() {
+    constexpr Deleter& GetDeleter() noexcept {
         return deleter_;
     }
 
-    const Deleter& GetDeleter() const {
+    constexpr const Deleter& GetDeleter() const noexcept {
         return deleter_;
     }
 
-    explicit operator bool() const {
+    constexpr explicit operator bool() const noexcept {
         return ptr_ != nullptr;
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Single-object dereference operators
 
-    std::add_lvalue_reference_t<T> operator*() const {
+    constexpr std::add_lvalue_reference_t<T> operator*() const {
         return *ptr_;
     }
 
-    T* operator->() const {
+    constexpr T* operator->() const noexcept {
         return ptr_;
     }
 
@@ -131,26 +136,27 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Constructors
 
-    explicit UniquePtr(T* ptr = nullptr) noexcept : ptr_(ptr) {
+    constexpr explicit UniquePtr(T* ptr = nullptr) noexcept : ptr_(ptr) {
     }
 
     template <typename D>
-    UniquePtr(T* ptr, D&& deleter) noexcept : ptr_(ptr), deleter_(std::forward<D>(deleter)) {
+    constexpr UniquePtr(T* ptr, D&& deleter) noexcept
+        : ptr_(ptr), deleter_(std::forward<D>(deleter)) {
     }
 
     template <typename U>
-    UniquePtr(UniquePtr<U, DefaultDelete<U>>&& other) noexcept : ptr_(other.Release()) {
+    constexpr UniquePtr(UniquePtr<U, DefaultDelete<U>>&& other) noexcept : ptr_(other.Release()) {
     }
 
     template <typename U, typename D>
-    UniquePtr(UniquePtr<U, D>&& other) noexcept
+    constexpr UniquePtr(UniquePtr<U, D>&& other) noexcept
         : ptr_(other.Release()), deleter_(std::forward<D>(other.GetDeleter())) {
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // `operator=`-s
 
-    UniquePtr& operator=(UniquePtr&& other) noexcept {
+    constexpr UniquePtr& operator=(UniquePtr&& other) noexcept {
         if (this == &other) {
             return *this;
         }
@@ -159,7 +165,7 @@ public:
         return *this;
     }
 
-    UniquePtr& operator=(std::nullptr_t) {
+    constexpr UniquePtr& operator=(std::nullptr_t) noexcept {
         Reset();
         return *this;
     }
@@ -167,62 +173,66 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Destructor
 
-    ~UniquePtr() {
-        deleter_(ptr_);
+    constexpr ~UniquePtr() {
+        if (ptr_) {
+            deleter_(ptr_);
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Modifiers
 
-    T* Release() {
+    constexpr T* Release() noexcept {
         T* ptr = ptr_;
         ptr_ = nullptr;
         return ptr;
     }
 
-    void Reset(T* ptr = nullptr) noexcept {
+    constexpr void Reset(T* ptr = nullptr) noexcept {
         T* old_ptr = ptr_;
         ptr_ = ptr;
-        deleter_(old_ptr);
+        if (old_ptr) {
+            deleter_(old_ptr);
+        }
     }
 
-    void Swap(UniquePtr& other) {
-        T* ptr = ptr_;
-        ptr_ = other.ptr_;
-        other.ptr_ = ptr;
+    constexpr void Swap(UniquePtr& other) noexcept(std::is_nothrow_swappable_v<Deleter>) {
+        using std::swap;
+        swap(ptr_, other.ptr_);
+        swap(deleter_, other.deleter_);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Observers
 
-    T* Get() const {
+    constexpr T* Get() const noexcept {
         return ptr_;
     }
 
-    Deleter& GetDeleter() {
+    constexpr Deleter& GetDeleter() noexcept {
         return deleter_;
     }
 
-    const Deleter& GetDeleter() const {
+    constexpr const Deleter& GetDeleter() const noexcept {
         return deleter_;
     }
 
-    explicit operator bool() const {
+    constexpr explicit operator bool() const noexcept {
         return ptr_ != nullptr;
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Single-object dereference operators
 
-    std::add_lvalue_reference_t<T> operator*() const {
+    constexpr std::add_lvalue_reference_t<T> operator*() const {
         return *ptr_;
     }
 
-    T* operator->() const {
+    constexpr T* operator->() const noexcept {
         return ptr_;
     }
 
-    T& operator[](std::size_t i) const {
+    constexpr T& operator[](std::size_t i) const {
         return ptr_[i];
     }
 
@@ -2,56 +2,53 @@
 
 #include "sw_fwd.h"  // Forward declaration
 
+#include <utility>
+
 // https://en.cppreference.com/w/cpp/memory/weak_ptr
-template <typename T>
-class WeakPtr {
+template <typename T, typename CountPolicy>
+class BasicWeakPtr {
 public:
+    using Policy = CountPolicy;
+    using Block = BasicControlBlock<CountPolicy>;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Constructors
 
-    WeakPtr() {
+    BasicWeakPtr() {
     }
 
-    WeakPtr(const WeakPtr& other) : ptr_(other.ptr_), control_block_(other.control_block_) {
+    BasicWeakPtr(const BasicWeakPtr& other)
+        : ptr_(other.ptr_), control_block_(other.control_block_) {
         if (control_block_) {
             control_block_->IncrementWeak();
         }
     }
 
     template <typename U>
-    WeakPtr(const WeakPtr<U>& other) : ptr_(other.ptr_), control_block_(other.control_block_) {
+    BasicWeakPtr(const BasicWeakPtr<U, CountPolicy>& other)
+        : ptr_(other.ptr_), control_block_(other.control_block_) {
         if (control_block_) {
             control_block_->IncrementWeak();
         }
     }
 
-    WeakPtr(WeakPtr&& other) : ptr_(other.Get()), control_block_(other.GetControlBlock()) {
-        if (control_block_) {
-            control_block_->IncrementWeak();
-        }
-        other.Reset();
+    BasicWeakPtr(BasicWeakPtr&& other) noexcept
+        : ptr_(other.ptr_), control_block_(other.control_block_) {
+        other.ptr_ = nullptr;
+        other.control_block_ = nullptr;
     }
 
     template <typename U>
-    WeakPtr(WeakPtr<U>&& other) : ptr_(other.Get()), control_block_(other.GetControlBlock()) {
-        if (control_block_) {
-            control_block_->IncrementWeak();
-        }
-        other.Reset();
+    BasicWeakPtr(BasicWeakPtr<U, CountPolicy>&& other) noexcept
+        : ptr_(other.ptr_), control_block_(other.control_block_) {
+        other.ptr_ = nullptr;
+        other.control_block_ = nullptr;
     }
 
     // Demote `SharedPtr`
     // #2 from https://en.cppreference.com/w/cpp/memory/weak_ptr/weak_ptr
-
-    WeakPtr(const SharedPtr<T>& other)
-        : ptr_(other.Get()), control_block_(other.GetControlBlock()) {
-        if (control_block_) {
-            control_block_->IncrementWeak();
-        }
-    }
-
     template <typename U>
-    WeakPtr(const SharedPtr<U>& other)
+    BasicWeakPtr(const BasicSharedPtr<U, CountPolicy>& other)
         : ptr_(other.Get()), control_block_(other.GetControlBlock()) {
         if (control_block_) {
             control_block_->IncrementWeak();
@@ -61,117 +58,38 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // `operator=`-s
 
-    WeakPtr& operator=(const WeakPtr& other) {
-        if (control_block_ == other.control_block_) {
-            ptr_ = other.ptr_;
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementWeak();
-        }
-        ptr_ = other.ptr_;
-        control_block_ = other.control_block_;
-        if (control_block_) {
-            control_block_->IncrementWeak();
-        }
+    BasicWeakPtr& operator=(const BasicWeakPtr& other) {
+        BasicWeakPtr(other).Swap(*this);
         return *this;
     }
 
     template <typename U>
-    WeakPtr& operator=(const WeakPtr<U>& other) {
-        if (control_block_ == other.control_block_) {
-            ptr_ = other.ptr_;
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementWeak();
-        }
-        ptr_ = other.ptr_;
-        control_block_ = other.control_block_;
-        if (control_block_) {
-            control_block_->IncrementWeak();
-        }
-        return *this;
-    }
-
-    WeakPtr& operator=(const SharedPtr<T>& other) {
-        if (control_block_ == other.GetControlBlock()) {
-            ptr_ = other.Get();
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementWeak();
-        }
-        ptr_ = other.Get();
-        control_block_ = other.GetControlBlock();
-        if (control_block_) {
-            control_block_->IncrementWeak();
-        }
+    BasicWeakPtr& operator=(const BasicWeakPtr<U, CountPolicy>& other) {
+        BasicWeakPtr(other).Swap(*this);
         return *this;
     }
 
     template <typename U>
-    WeakPtr& operator=(const SharedPtr<U>& other) {
-        if (control_block_ == other.GetControlBlock()) {
-            ptr_ = other.Get();
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementWeak();
-        }
-        ptr_ = other.Get();
-        control_block_ = other.GetControlBlock();
-        if (control_block_) {
-            control_block_->IncrementWeak();
-        }
+    BasicWeakPtr& operator=(const BasicSharedPtr<U, CountPolicy>& other) {
+        BasicWeakPtr(other).Swap(*this);
         return *this;
     }
 
-    WeakPtr& operator=(WeakPtr&& other) {
-        if (control_block_ == other.control_block_) {
-            ptr_ = other.ptr_;
-            if (control_block_) {
-                control_block_->DecrementWeak();
-            }
-            other.ptr_ = nullptr;
-            other.control_block_ = nullptr;
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementWeak();
-        }
-        ptr_ = other.ptr_;
-        control_block_ = other.control_block_;
-        other.ptr_ = nullptr;
-        other.control_block_ = nullptr;
+    BasicWeakPtr& operator=(BasicWeakPtr&& other) noexcept {
+        BasicWeakPtr(std::move(other)).Swap(*this);
         return *this;
     }
 
     template <typename U>
-    WeakPtr& operator=(WeakPtr<U>&& other) {
-        if (control_block_ == other.control_block_) {
-            ptr_ = other.ptr_;
-            if (control_block_) {
-                control_block_->DecrementWeak();
-            }
-            other.ptr_ = nullptr;
-            other.control_block_ = nullptr;
-            return *this;
-        }
-        if (control_block_) {
-            control_block_->DecrementWeak();
-        }
-        ptr_ = other.ptr_;
-        control_block_ = other.control_block_;
-        other.ptr_ = nullptr;
-        other.control_block_ = nullptr;
+    BasicWeakPtr& operator=(BasicWeakPtr<U, CountPolicy>&& other) noexcept {
+        BasicWeakPtr(std::move(other)).Swap(*this);
         return *this;
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Destructor
 
-    ~WeakPtr() {
+    ~BasicWeakPtr() {
         if (control_block_) {
             control_block_->DecrementWeak();
         }
@@ -181,21 +99,12 @@ public:
     // Modifiers
 
     void Reset() {
-        if (control_block_) {
-            control_block_->DecrementWeak();
-        }
-        ptr_ = nullptr;
-        control_block_ = nullptr;
+        BasicWeakPtr().Swap(*this);
     }
 
-    void Swap(WeakPtr& other) {
-        auto ptr = other.ptr_;
-        other.ptr_ = ptr_;
-        ptr_ = ptr;
-
-        auto cb = other.control_block_;
-        other.control_block_ = control_block_;
-        control_block_ = cb;
+    void Swap(BasicWeakPtr& other) noexcept {
+        std::swap(ptr_, other.ptr_);
+        std::swap(control_block_, other.control_block_);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -205,43 +114,32 @@ public:
         if (!control_block_) {
             return 0;
         }
-        return control_block_->shared_count_;
+        return control_block_->SharedCount();
     }
 
     bool Expired() const {
         return !UseCount();
     }
 
-    SharedPtr<T> Lock() const {
-        if (Expired()) {
-            if (control_block_) {
-                control_block_->IncrementShared();
-            }
-            return SharedPtr<T>(nullptr, control_block_);
-        }
-        if (control_block_) {
-            control_block_->IncrementShared();
+    BasicSharedPtr<T, CountPolicy> Lock() const {
+        if (control_block_ && control_block_->IncrementSharedIfNotZero()) {
+            return BasicSharedPtr<T, CountPolicy>(ptr_, control_block_);
         }
-        return SharedPtr<T>(ptr_, control_block_);
+        return BasicSharedPtr<T, CountPolicy>();
     }
 
     T* Get() const {
         return ptr_;
     }
 
-    ControlBlock* GetControlBlock() const {
+    Block* GetControlBlock() const {
         return control_block_;
     }
 
 private:
     T* ptr_ = nullptr;
-    ControlBlock* control_block_ = nullptr;
+    Block* control_block_ = nullptr;
 
-    template <typename U>
-    friend class WeakPtr;
-
-    friend struct EnableSharedFromThisBase;
-
-    template <typename U>
-    friend struct EnableSharedFromThis;
+    template <typename U, typename P>
+    friend class BasicWeakPtr;
 };